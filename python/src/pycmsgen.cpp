@@ -302,33 +302,39 @@ static int _add_clauses_from_array(Solver *self, const size_t array_length, cons
         PyErr_SetString(PyExc_ValueError, "last clause not terminated by zero");
         return 0;
     }
-    size_t k = 0;
-    long val = 0;
-    std::vector<Lit>& lits = self->tmp_cl_lits;
-    for (val = (long) array[k]; k < array_length; val = (long) array[++k]) {
-        lits.clear();
-        long int max_var = 0;
-        for (; k < array_length && val != 0; val = (long) array[++k]) {
-            long var;
-            bool sign;
+
+    //Clauses are handed over in batches of about a million literals
+    std::vector<Lit> lits;
+    std::vector<size_t> offsets;
+    long int max_var = -1;
+    offsets.push_back(0);
+    for (size_t k = 0; k < array_length; k++) {
+        const long val = (long) array[k];
+        if (val != 0) {
             if (val > std::numeric_limits<int>::max()/2
                 || val < std::numeric_limits<int>::min()/2
             ) {
                 PyErr_Format(PyExc_ValueError, "integer %ld is too small or too large", val);
                 return 0;
             }
-
-            sign = (val < 0);
-            var = std::abs(val) - 1;
+            const long var = std::abs(val) - 1;
             max_var = std::max(var, max_var);
-
-            lits.push_back(Lit(var, sign));
+            lits.push_back(Lit(var, val < 0));
+            continue;
         }
-        if (!lits.empty()) {
+
+        //An empty clause makes the problem UNSAT, as with add_clause()
+        offsets.push_back(lits.size());
+        if (lits.size() >= (1U << 20)
+            || offsets.size() > (1U << 20)
+            || k+1 == array_length
+        ) {
             if (max_var >= (long int)self->cmsat->nVars()) {
                 self->cmsat->new_vars(max_var-(long int)self->cmsat->nVars()+1);
             }
-            self->cmsat->add_clause(lits);
+            self->cmsat->add_clauses(lits, offsets);
+            lits.clear();
+            offsets.resize(1);
         }
     }
     return 1;
@@ -690,6 +696,219 @@ static PyObject* solve(Solver *self, PyObject *args, PyObject *kwds)
     return result;
 }
 
+typedef struct {
+    PyObject_HEAD
+    uint8_t* data;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} Samples;
+
+static void Samples_dealloc(Samples* self)
+{
+    PyMem_Free(self->data);
+    Py_TYPE(self)->tp_free ((PyObject*) self);
+}
+
+static int Samples_getbuffer(Samples* self, Py_buffer* view, int flags)
+{
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "samples are read-only");
+        view->obj = NULL;
+        return -1;
+    }
+    view->obj = (PyObject*)self;
+    Py_INCREF(self);
+    view->buf = self->data;
+    view->len = self->shape[0]*self->shape[1];
+    view->readonly = 1;
+    view->itemsize = 1;
+    view->format = (flags & PyBUF_FORMAT) ? (char*)"B" : NULL;
+    //Without PyBUF_ND the consumer gets a flat byte buffer, which must have
+    //ndim 1 and no shape
+    view->ndim = (flags & PyBUF_ND) ? 2 : 1;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+static PyBufferProcs Samples_as_buffer = {
+    (getbufferproc)Samples_getbuffer,
+    0
+};
+
+static PyTypeObject pycmsgen_SamplesType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "pycmsgen.Samples",         /*tp_name*/
+    sizeof(Samples),            /*tp_basicsize*/
+    0,                          /*tp_itemsize*/
+    (destructor)Samples_dealloc, /*tp_dealloc*/
+    0,                          /*tp_print*/
+    0,                          /*tp_getattr*/
+    0,                          /*tp_setattr*/
+    0,                          /*tp_compare*/
+    0,                          /*tp_repr*/
+    0,                          /*tp_as_number*/
+    0,                          /*tp_as_sequence*/
+    0,                          /*tp_as_mapping*/
+    0,                          /*tp_hash */
+    0,                          /*tp_call*/
+    0,                          /*tp_str*/
+    0,                          /*tp_getattro*/
+    0,                          /*tp_setattro*/
+    &Samples_as_buffer,         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT,         /*tp_flags*/
+    "Samples returned by Solver.sample(), exported through the buffer protocol", /* tp_doc */
+};
+
+PyDoc_STRVAR(sample_doc,
+"sample(n, vars=None, assumptions=None, packed=False)\n\
+Get n random solutions at once. The sampling loop runs without the GIL and\n\
+the search state is kept between samples, so this is much faster than\n\
+calling solve() n times.\n\
+\n\
+.. example:: \n\
+    >>> import numpy as np\n\
+    >>> s = Solver()\n\
+    >>> s.add_clause([1, 2])\n\
+    >>> samples = np.asarray(s.sample(1000))\n\
+    >>> samples.shape\n\
+    (1000, 2)\n\
+\n\
+:param n: Number of samples\n\
+:type n: <int>\n\
+:param vars: (Optional) Variables to return the values of, in this order.\n\
+    Default: all variables, 1..nb_vars()\n\
+:type vars: <list>\n\
+:param assumptions: (Optional) Literals that must hold in all samples\n\
+:type assumptions: <list>\n\
+:param packed: (Optional) If True, each sample is a bitset: bit i is at\n\
+    byte i/8, bit i%8, and is set iff vars[i] is True\n\
+:type packed: <bool>\n\
+:return: A 2D memoryview of unsigned bytes, one row per sample, with 1 for\n\
+    True and 0 for False. It can be passed to numpy.asarray() without a\n\
+    copy. If the problem is unsatisfiable, it has no rows. If a time or\n\
+    conflict limit was hit, it has the rows done until then.\n\
+:rtype: <memoryview>"
+);
+
+static int parse_sample_vars(PyObject* vars, SATSolver* cmsat, std::vector<uint32_t>& out)
+{
+    PyObject *iterator = PyObject_GetIter(vars);
+    if (iterator == NULL) {
+        PyErr_SetString(PyExc_TypeError, "iterable object expected");
+        return 0;
+    }
+
+    PyObject *lit;
+    while ((lit = PyIter_Next(iterator)) != NULL) {
+        long var;
+        bool sign;
+        int ret = convert_lit_to_sign_and_var(lit, var, sign);
+        Py_DECREF(lit);
+        if (!ret) {
+            Py_DECREF(iterator);
+            return 0;
+        }
+        if (sign || var >= cmsat->nVars()) {
+            Py_DECREF(iterator);
+            PyErr_Format(PyExc_ValueError, "Variable %ld is not a variable of the solver", (sign ? -1 : 1)*(var+1));
+            return 0;
+        }
+        out.push_back(var);
+    }
+    Py_DECREF(iterator);
+    if (PyErr_Occurred()) {
+        return 0;
+    }
+
+    return 1;
+}
+
+static PyObject* sample(Solver *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t num_samples = 0;
+    PyObject* vars_obj = NULL;
+    PyObject* assumptions = NULL;
+    int packed = 0;
+
+    static char const* kwlist[] = {"n", "vars", "assumptions", "packed", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|OOp", const_cast<char**>(kwlist), &num_samples, &vars_obj, &assumptions, &packed)) {
+        return NULL;
+    }
+    if (num_samples < 0) {
+        PyErr_SetString(PyExc_ValueError, "number of samples must be at least 0");
+        return NULL;
+    }
+
+    std::vector<uint32_t> vars;
+    if (vars_obj && vars_obj != Py_None) {
+        if (!parse_sample_vars(vars_obj, self->cmsat, vars)) {
+            return NULL;
+        }
+    } else {
+        for(uint32_t i = 0; i < self->cmsat->nVars(); i++) {
+            vars.push_back(i);
+        }
+    }
+    std::vector<Lit> assumption_lits;
+    if (assumptions && assumptions != Py_None) {
+        if (!parse_assumption_lits(assumptions, self->cmsat, assumption_lits)) {
+            return NULL;
+        }
+    }
+
+    const Py_ssize_t row = packed ?
+        (Py_ssize_t)SATSolver::get_sample_bytes(vars.size()) : (Py_ssize_t)vars.size();
+    if (row > 0 && num_samples > PY_SSIZE_T_MAX/row) {
+        PyErr_SetString(PyExc_MemoryError, "too many samples requested");
+        return NULL;
+    }
+    Samples* samples = PyObject_New(Samples, &pycmsgen_SamplesType);
+    if (samples == NULL) {
+        return NULL;
+    }
+    //PyMem_Malloc(0) gives a valid pointer, so no special case for 0 samples
+    samples->data = (uint8_t*)PyMem_Malloc(num_samples*row);
+    if (samples->data == NULL) {
+        Py_DECREF(samples);
+        return PyErr_NoMemory();
+    }
+    //Nobody else can see the samples yet, so they can be filled without the GIL
+    uint8_t* out = samples->data;
+
+    uint64_t done = 0;
+    if (num_samples > 0) {
+        Py_BEGIN_ALLOW_THREADS      /* release GIL */
+        if (packed) {
+            self->cmsat->get_samples(num_samples, out, &vars, &done, &assumption_lits);
+        } else {
+            self->cmsat->sample(
+                num_samples
+                , [&](const std::vector<lbool>& model) {
+                    uint8_t* at = out + done*row;
+                    for(size_t i = 0; i < vars.size(); i++) {
+                        at[i] = model[vars[i]] == l_True;
+                    }
+                    done++;
+                    return true;
+                }
+                , &assumption_lits
+            );
+        }
+        Py_END_ALLOW_THREADS
+    }
+    samples->shape[0] = done;
+    samples->shape[1] = row;
+    samples->strides[0] = row;
+    samples->strides[1] = 1;
+
+    PyObject* view = PyMemoryView_FromObject((PyObject*)samples);
+    Py_DECREF(samples);
+    return view;
+}
+
 PyDoc_STRVAR(is_satisfiable_doc,
 "is_satisfiable()\n\
 Return satisfiability of the system.\n\
@@ -759,6 +978,7 @@ static PyObject* get_model(Solver *self) {
 
 static PyMethodDef Solver_methods[] = {
     {"solve",     (PyCFunction) solve,       METH_VARARGS | METH_KEYWORDS, solve_doc},
+    {"sample",    (PyCFunction) sample,      METH_VARARGS | METH_KEYWORDS, sample_doc},
     {"set_var_weight",(PyCFunction) set_var_weight,  METH_VARARGS | METH_KEYWORDS, set_var_weight_doc},
     {"add_clause",(PyCFunction) add_clause,  METH_VARARGS | METH_KEYWORDS, add_clause_doc},
     {"add_clauses", (PyCFunction) add_clauses,  METH_VARARGS | METH_KEYWORDS, add_clauses_doc},
@@ -840,6 +1060,9 @@ MODULE_INIT_FUNC(pycmsgen)
         // In pure Python2: return nothing.
         return NULL;
     }
+    if (PyType_Ready(&pycmsgen_SamplesType) < 0) {
+        return NULL;
+    }
 
     static struct PyModuleDef moduledef = {
         PyModuleDef_HEAD_INIT,  /* m_base */
@@ -0,0 +1,239 @@
+# -*- coding: utf-8 -*-
+#
+# CMSGen
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+# Tests of the pycmsgen-only API. test_pycryptosat.py is kept from the
+# pycryptosat bindings.
+
+from __future__ import print_function
+from array import array
+import ctypes
+import sys
+import unittest
+
+import pycmsgen
+from pycmsgen import Solver
+
+# -------------------------- test clauses --------------------------------
+
+# Units fixing 10 vars: 1 -2 3 -4 -5 6 -7 -8 9 10
+model10 = [1, -2, 3, -4, -5, 6, -7, -8, 9, 10]
+
+
+class Py_buffer(ctypes.Structure):
+    _fields_ = [
+        ("buf", ctypes.c_void_p),
+        ("obj", ctypes.c_void_p),
+        ("len", ctypes.c_ssize_t),
+        ("itemsize", ctypes.c_ssize_t),
+        ("readonly", ctypes.c_int),
+        ("ndim", ctypes.c_int),
+        ("format", ctypes.c_char_p),
+        ("shape", ctypes.POINTER(ctypes.c_ssize_t)),
+        ("strides", ctypes.POINTER(ctypes.c_ssize_t)),
+        ("suboffsets", ctypes.POINTER(ctypes.c_ssize_t)),
+        ("internal", ctypes.c_void_p),
+    ]
+
+PyBUF_SIMPLE = 0
+
+# -------------------------- actual unit tests ---------------------------
+
+
+class TestSample(unittest.TestCase):
+
+    def setUp(self):
+        self.solver = Solver(seed=0)
+
+    def add_model10(self):
+        for lit in model10:
+            self.solver.add_clause([lit])
+
+    def test_shape_and_values(self):
+        self.add_model10()
+        samples = self.solver.sample(5)
+        self.assertEqual(samples.shape, (5, 10))
+        self.assertEqual(samples.format, "B")
+        self.assertTrue(samples.readonly)
+        for row in samples.tolist():
+            self.assertEqual(row, [1 if l > 0 else 0 for l in model10])
+
+    def test_packed_bit_order(self):
+        self.add_model10()
+        samples = self.solver.sample(3, packed=True)
+        self.assertEqual(samples.shape, (3, 2))
+        # bit i is byte i/8, bit i%8: vars 1, 3, 6 in byte 0, vars 9, 10 in byte 1
+        for row in samples.tolist():
+            self.assertEqual(row, [1 | 4 | 32, 1 | 2])
+
+    def test_vars_order(self):
+        self.add_model10()
+        samples = self.solver.sample(4, vars=[10, 1, 2, 3])
+        self.assertEqual(samples.shape, (4, 4))
+        for row in samples.tolist():
+            self.assertEqual(row, [1, 1, 0, 1])
+
+        packed = self.solver.sample(4, vars=[10, 1, 2, 3], packed=True)
+        self.assertEqual(packed.shape, (4, 1))
+        for row in packed.tolist():
+            self.assertEqual(row, [1 | 2 | 8])
+
+    def test_wrong_vars(self):
+        self.add_model10()
+        self.assertRaises(ValueError, self.solver.sample, 1, vars=[11])
+        self.assertRaises(ValueError, self.solver.sample, 1, vars=[-1])
+        self.assertRaises(ValueError, self.solver.sample, -1)
+
+    def test_assumptions(self):
+        self.solver.add_clause([1, 2])
+        self.solver.add_clause([3, 4, 5])
+        samples = self.solver.sample(50, assumptions=[-1, -4])
+        self.assertEqual(samples.shape, (50, 5))
+        for row in samples.tolist():
+            self.assertEqual(row[0], 0)
+            self.assertEqual(row[1], 1)
+            self.assertEqual(row[3], 0)
+
+        # Not kept for later calls
+        seen = set(row[0] for row in self.solver.sample(50).tolist())
+        self.assertEqual(seen, set([0, 1]))
+
+    def test_unsat_assumptions(self):
+        self.solver.add_clause([1, 2])
+        samples = self.solver.sample(5, assumptions=[-1, -2])
+        self.assertEqual(samples.shape, (0, 2))
+
+    def test_unsat(self):
+        self.solver.add_clause([1])
+        self.solver.add_clause([-1])
+        samples = self.solver.sample(5)
+        self.assertEqual(samples.shape[0], 0)
+        self.assertEqual(samples.tolist(), [])
+        self.assertEqual(self.solver.sample(5, packed=True).shape[0], 0)
+
+    def test_zero_samples(self):
+        self.add_model10()
+        self.assertEqual(self.solver.sample(0).shape, (0, 10))
+
+    def test_simple_buffer(self):
+        # A consumer that does not ask for PyBUF_ND gets a flat buffer
+        self.add_model10()
+        samples = self.solver.sample(3)
+        view = Py_buffer()
+        get = ctypes.pythonapi.PyObject_GetBuffer
+        get.argtypes = [ctypes.py_object, ctypes.POINTER(Py_buffer), ctypes.c_int]
+        release = ctypes.pythonapi.PyBuffer_Release
+        release.argtypes = [ctypes.POINTER(Py_buffer)]
+        self.assertEqual(get(samples.obj, ctypes.byref(view), PyBUF_SIMPLE), 0)
+        try:
+            self.assertEqual(view.ndim, 1)
+            self.assertFalse(view.shape)
+            self.assertEqual(view.len, 30)
+            self.assertEqual(ctypes.string_at(view.buf, view.len), samples.tobytes())
+        finally:
+            release(ctypes.byref(view))
+        self.assertEqual(bytes(samples.obj), samples.tobytes())
+
+
+class TestAddClausesArray(unittest.TestCase):
+    """add_clauses() of a flat array goes through the bulk insertion of the
+    library. It must end up with the same solver as add_clause() one by one"""
+
+    # 3-SAT on vars 1..20. The first literal of each clause is TRUE when the
+    # odd vars are TRUE and the even ones FALSE
+    base = [[a if a % 2 else -a, -b, c] for a, b, c in
+            (((7*i) % 20 + 1, (11*i + 3) % 20 + 1, (13*i + 5) % 20 + 1)
+             for i in range(60))]
+
+    # Vars 21..30 are beyond nb_vars() when this batch is added. [21]
+    # propagates over the binary before it in the same batch
+    odd = [[-21, 22], [-22, 23, 24], [23, -25, 26, 27], [21], [24, 24, -28, 24],
+           [25, -25, 29], [-23, -24, 30], [5, -5], [28, 29, 30, 2], [-26, 26, -26],
+           [27, -29]]
+
+    def solvers(self, batches):
+        bulk = Solver(seed=0)
+        one = Solver(seed=0)
+        for batch in batches:
+            flat = []
+            for cl in batch:
+                flat += cl + [0]
+            bulk.add_clauses(array('i', flat))
+            for cl in batch:
+                one.add_clause(cl)
+        self.assertEqual(bulk.nb_vars(), one.nb_vars())
+        return bulk, one
+
+    def check_same(self, batches, expected):
+        bulk, one = self.solvers(batches)
+        res = bulk.solve()
+        self.assertEqual(res[0], expected)
+        self.assertEqual(res, one.solve())
+        self.assertEqual(bulk.sample(20).tolist(), one.sample(20).tolist())
+
+    def test_sat(self):
+        self.check_same([self.base, self.odd], True)
+
+    def test_single_batch(self):
+        self.check_same([self.base[:10] + self.odd + self.base[10:]], True)
+
+    def test_empty_clause(self):
+        self.check_same([self.base, [[1, 2], [], [3, 4]]], False)
+
+    def test_empty_clause_first(self):
+        self.check_same([[[], [1, 2]]], False)
+
+    def test_conflicting_units(self):
+        units = [[2, 23], [5], [-5, 6, 6], [7, -7], [-6], [8, 9]]
+        self.check_same([self.base, units], False)
+
+# ------------------------------------------------------------------------
+
+
+def run():
+    print("sys.prefix: %s" % sys.prefix)
+    print("sys.version: %s" % sys.version)
+    try:
+        print("pycmsgen version: %r" % pycmsgen.__version__)
+    except AttributeError:
+        pass
+    suite = unittest.TestSuite()
+    loader = unittest.TestLoader()
+    suite.addTest(loader.loadTestsFromTestCase(TestSample))
+    suite.addTest(loader.loadTestsFromTestCase(TestAddClausesArray))
+
+    runner = unittest.TextTestRunner(verbosity=2)
+    result = runner.run(suite)
+
+    n_errors = len(result.errors)
+    n_failures = len(result.failures)
+
+    if n_errors or n_failures:
+        print('\n\nSummary: %d errors and %d failures reported\n'%\
+            (n_errors, n_failures))
+
+    print()
+
+    sys.exit(n_errors+n_failures)
+
+
+if __name__ == '__main__':
+    run()
@@ -47,6 +47,7 @@ def gen_modules(version):
         sources = ["python/src/pycmsgen.cpp",
                    "python/src/GitSHA1.cpp",
                    "src/clauseallocator.cpp",
+                   "src/hugealloc.cpp",
                    "src/clausecleaner.cpp",
                    "src/clauseusagestats.cpp",
                    "src/cnf.cpp",
@@ -64,6 +65,7 @@ def gen_modules(version):
                    "src/prober.cpp",
                    "src/propengine.cpp",
                    "src/reducedb.cpp",
+                   "src/rowkernels.cpp",
                    "src/sccfinder.cpp",
                    "src/searcher.cpp",
                    "src/searchstats.cpp",
@@ -75,6 +77,7 @@ def gen_modules(version):
                    "src/subsumeimplicit.cpp",
                    "src/subsumestrengthen.cpp",
                    "src/varreplacer.cpp",
+                   "src/workerpool.cpp",
                    "src/xorfinder.cpp"
                ],
         extra_compile_args = extra_compile_args_val,
@@ -162,6 +162,10 @@ Literals are allocated by an external allocator that allocates enough space
 for the class that it can hold the literals as well. I.e. it malloc()-s
     sizeof(Clause)+LENGHT*sizeof(Lit)
 to hold the clause.
+
+Only what propagation and subsumption need is kept here, next to the
+literals. The ClauseStats live in the ClauseAllocator, see
+ClauseAllocator::stats(), so a watch visit doesn't pull them into cache.
 */
 class Clause
 {
@@ -190,16 +194,15 @@ public:
 
 public:
     cl_abst_type abst;
-    ClauseStats stats;
+    uint32_t stats_id; ///<Index of the ClauseStats in the ClauseAllocator
     uint32_t mySize;
 
     template<class V>
-    Clause(const V& ps, const uint32_t _introduced_at_conflict)
+    Clause(const V& ps, const uint32_t _stats_id)
     {
         //assert(ps.size() > 2);
 
-        stats.last_touched = _introduced_at_conflict;
-        stats.glue = std::min<uint32_t>(stats.glue, ps.size());
+        stats_id = _stats_id;
         isFreed = false;
         mySize = ps.size();
         isRed = false;
@@ -306,10 +309,8 @@ public:
         isRed = false;
     }
 
-    void makeRed(const uint32_t newGlue)
+    void makeRed()
     {
-        stats.glue = newGlue;
-        stats.activity = 0.0;
         isRed = true;
     }
 
@@ -374,11 +375,6 @@ public:
         isFreed = true;
     }
 
-    void combineStats(const ClauseStats& other)
-    {
-        stats = ClauseStats::combineStats(stats, other);
-    }
-
     void set_distilled(bool distilled)
     {
         is_distilled = distilled;
@@ -399,15 +395,6 @@ public:
         occurLinked = toset;
     }
 
-    void print_extra_stats() const
-    {
-        cout
-        << "Clause size " << std::setw(4) << size();
-        if (red()) {
-            cout << " glue : " << std::setw(4) << stats.glue;
-        }
-        cout << endl;
-    }
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Clause& cl)
@@ -52,98 +52,168 @@ using std::endl;
 //For mild debug info:
 //#define DEBUG_CLAUSEALLOCATOR
 
-//For listing each and every clause location:
-//#define DEBUG_CLAUSEALLOCATOR2
+#define MIN_COMPACT_SIZE (100ULL*1000ULL)
 
-#define MIN_LIST_SIZE (50000 * (sizeof(Clause) + 4*sizeof(Lit))/sizeof(BASE_DATA_TYPE))
-#define ALLOC_GROW_MULT 1.5
-
-#define MAXSIZE ((1ULL << (EFFECTIVELY_USEABLE_BITS))-1)
-
-ClauseAllocator::ClauseAllocator() :
-    dataStart(NULL)
-    , size(0)
-    , capacity(0)
-    , currentlyUsedSize(0)
+ClauseAllocator::ClauseAllocator()
 {
-    assert(MIN_LIST_SIZE < MAXSIZE);
+    static_assert(chunk_bytes/sizeof(BASE_DATA_TYPE) == (1ULL << chunk_bits)
+        , "chunk_bits must match the chunk size");
 }
 
 /**
-@brief Frees all stacks
+@brief Frees all chunks
 */
 ClauseAllocator::~ClauseAllocator()
 {
-    free(dataStart);
+    for(uint32_t i = 0; i < chunks.size(); i++) {
+        if (chunks[i].mem != NULL) {
+            free_chunk(i);
+        }
+    }
 }
 
-void* ClauseAllocator::allocEnough(
-    uint32_t num_lits
-) {
-    //Try to quickly find a place at the end of a dataStart
-    uint64_t neededbytes = sizeof(Clause) + sizeof(Lit)*num_lits;
-    uint64_t needed
-        = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
-
-    if (size + needed > capacity) {
-        //Grow by default, but don't go under or over the limits
-        uint64_t newcapacity = capacity * ALLOC_GROW_MULT;
-        newcapacity = std::max<size_t>(newcapacity, MIN_LIST_SIZE);
-        while (newcapacity < size+needed) {
-            newcapacity *= ALLOC_GROW_MULT;
-        }
-        assert(newcapacity >= size+needed);
-        newcapacity = std::min<size_t>(newcapacity, MAXSIZE);
+void ClauseAllocator::set_huge_pages(const HugePages mode)
+{
+    assert(chunks.empty() && "Must be set before the first clause is allocated");
+    huge_pages = mode;
+}
+
+uint64_t ClauseAllocator::words_needed(const uint64_t num_lits)
+{
+    const uint64_t neededbytes = sizeof(Clause) + sizeof(Lit)*num_lits;
+    return neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+}
 
-        //Oops, not enough space anyway
-        if (newcapacity < size + needed) {
-            std::cerr
-            << "ERROR: memory manager can't handle the load."
+uint32_t ClauseAllocator::chunk_of(const Clause* cl) const
+{
+    const BASE_DATA_TYPE* start = (const BASE_DATA_TYPE*)((uintptr_t)cl & ~(uintptr_t)(chunk_bytes-1));
+    return slot_chunk[*start];
+}
+
+uint32_t ClauseAllocator::new_chunk(const ClRegion region, const uint64_t words)
+{
+    //The first word holds the slot number
+    const uint32_t num_slots = (words + 1 + chunk_mask) >> chunk_bits;
+
+    //Find num_slots free slots in a row
+    uint32_t first_slot = 0;
+    uint32_t found = 0;
+    for(; first_slot + found < slot_chunk.size() && found < num_slots;) {
+        if (slot_chunk[first_slot + found] == std::numeric_limits<uint32_t>::max()) {
+            found++;
+        } else {
+            first_slot += found+1;
+            found = 0;
+        }
+    }
+    if (first_slot + num_slots > max_slots) {
+        std::cerr
+        << "ERROR: memory manager can't handle the load."
 #ifndef LARGE_OFFSETS
-            << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
+        << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
 #endif
-            << " size: " << size
-            << " needed: " << needed
-            << " newcapacity: " << newcapacity
-            << endl;
-            std::cout
-            << "ERROR: memory manager can't handle the load."
+        << " slots used: " << slot_chunk.size()
+        << " needed: " << num_slots
+        << endl;
+        std::cout
+        << "ERROR: memory manager can't handle the load."
 #ifndef LARGE_OFFSETS
-            << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
+        << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
 #endif
-            << " size: " << size
-            << " needed: " << needed
-            << " newcapacity: " << newcapacity
-            << endl;
+        << " slots used: " << slot_chunk.size()
+        << " needed: " << num_slots
+        << endl;
 
-            throw std::bad_alloc();
-        }
+        throw std::bad_alloc();
+    }
+
+    const size_t bytes = (size_t)num_slots*chunk_bytes;
+    void* mem = NULL;
+    try {
+        mem = huge_alloc(bytes, chunk_bytes, huge_pages);
+    } catch (std::bad_alloc&) {
+        std::cerr
+        << "ERROR: while allocating clause space"
+        << endl;
 
-        //Reallocate data
-        BASE_DATA_TYPE* new_dataStart;
-        new_dataStart = (BASE_DATA_TYPE*)realloc(
-            dataStart
-            , newcapacity*sizeof(BASE_DATA_TYPE)
-        );
+        throw;
+    }
 
-        //Realloc failed?
-        if (new_dataStart == NULL) {
-            std::cerr
-            << "ERROR: while reallocating clause space"
-            << endl;
+    uint32_t at;
+    if (free_chunks.empty()) {
+        at = chunks.size();
+        chunks.push_back(Chunk());
+    } else {
+        at = free_chunks.back();
+        free_chunks.pop_back();
+        chunks[at] = Chunk();
+    }
+    Chunk& ch = chunks[at];
+    ch.mem = (BASE_DATA_TYPE*)mem;
+    ch.capacity = bytes/sizeof(BASE_DATA_TYPE);
+    ch.pos = 1;
+    ch.first_slot = first_slot;
+    ch.num_slots = num_slots;
+    ch.region = region;
+    ch.mem[0] = first_slot;
+
+    if (slot_chunk.size() < first_slot + num_slots) {
+        slot_chunk.resize(first_slot + num_slots, std::numeric_limits<uint32_t>::max());
+        slot_start.resize(first_slot + num_slots, NULL);
+    }
+    for(uint32_t i = 0; i < num_slots; i++) {
+        slot_chunk[first_slot + i] = at;
+        //Offsets of later slots continue where the previous slot ended
+        slot_start[first_slot + i] = ch.mem + ((uint64_t)i << chunk_bits);
+    }
+    regions[(uint32_t)region].chunks.push_back(at);
 
-            throw std::bad_alloc();
-        }
-        dataStart = new_dataStart;
+    return at;
+}
 
-        //Update capacity to reflect the update
-        capacity = newcapacity;
+void ClauseAllocator::free_chunk(const uint32_t at)
+{
+    Chunk& ch = chunks[at];
+    for(uint32_t i = 0; i < ch.num_slots; i++) {
+        slot_chunk[ch.first_slot + i] = std::numeric_limits<uint32_t>::max();
+        slot_start[ch.first_slot + i] = NULL;
+    }
+    huge_free(ch.mem, ch.capacity*sizeof(BASE_DATA_TYPE), huge_pages);
+    ch = Chunk();
+    free_chunks.push_back(at);
+}
+
+void* ClauseAllocator::allocEnough(
+    const uint32_t num_lits
+    , const ClRegion region
+) {
+    const uint64_t needed = words_needed(num_lits);
+    Region& reg = regions[(uint32_t)region];
+
+    Chunk* ch = NULL;
+    if (needed + 1 > (1ULL << chunk_bits)) {
+        //Gets a chunk to itself
+        ch = &chunks[new_chunk(region, needed)];
+    } else {
+        if (reg.cur_chunk != std::numeric_limits<uint32_t>::max()) {
+            ch = &chunks[reg.cur_chunk];
+        }
+        if (ch == NULL || ch->pos + needed > ch->capacity) {
+            if (ch != NULL) {
+                //The end of the old chunk is lost
+                reg.size += ch->capacity - ch->pos;
+                ch->pos = ch->capacity;
+            }
+            reg.cur_chunk = new_chunk(region, needed);
+            ch = &chunks[reg.cur_chunk];
+        }
     }
 
     //Add clause to the set
-    Clause* pointer = (Clause*)(dataStart + size);
-    size += needed;
-    currentlyUsedSize += needed;
+    Clause* pointer = (Clause*)(ch->mem + ch->pos);
+    ch->pos += needed;
+    reg.size += needed;
+    reg.used += needed;
 
     return pointer;
 }
@@ -151,12 +221,13 @@ void* ClauseAllocator::allocEnough(
 /**
 @brief Given the pointer of the clause it finds a 32-bit offset for it
 
-Calculates the stack frame and the position of the pointer in the stack, and
-rerturns a 32-bit value that is a concatenation of these two
+The chunk starts with its slot number, and the chunk is aligned to its size,
+so the slot is found by rounding the pointer down
 */
 ClOffset ClauseAllocator::get_offset(const Clause* ptr) const
 {
-    return ((BASE_DATA_TYPE*)ptr - dataStart);
+    const Chunk& ch = chunks[chunk_of(ptr)];
+    return ((ClOffset)ch.first_slot << chunk_bits) + ((BASE_DATA_TYPE*)ptr - ch.mem);
 }
 
 /**
@@ -164,29 +235,34 @@ ClOffset ClauseAllocator::get_offset(const Clause* ptr) const
 
 If clause was binary, it frees it in quite a normal way. If it isn't, then it
 needs to set the data in the Clause that it has been freed, and updates the
-stack it belongs to such that the stack can now that its effectively used size
+region it belongs to such that the region can now that its effectively used size
 is smaller
 
-NOTE: The size of claues can change. Therefore, currentlyUsedSizes can in fact
+NOTE: The size of claues can change. Therefore, the used size can in fact
 be incorrect, since it was incremented by the ORIGINAL size of the clause, but
 when the clause is "freed", it is decremented by the POTENTIALLY SMALLER size
-of the clause. Therefore, the "currentlyUsedSizes" is an overestimation!!
+of the clause. Therefore, the used size is an overestimation!!
 */
 void ClauseAllocator::clauseFree(Clause* cl)
 {
     assert(!cl->freed());
+    Chunk& ch = chunks[chunk_of(cl)];
+    Region& reg = regions[(uint32_t)ch.region];
 
     bool quick_freed = false;
     #ifdef USE_GAUSS
     if (cl->gauss_temp_cl()) {
-        uint64_t neededbytes = (sizeof(Clause) + sizeof(Lit)*cl->size());
-        uint64_t needed
-            = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
-
-        if (((BASE_DATA_TYPE*)cl + needed) == (dataStart + size)) {
-            size -= needed;
-            currentlyUsedSize -= needed;
+        const uint64_t needed = words_needed(cl->size());
+        if (((BASE_DATA_TYPE*)cl + needed) == (ch.mem + ch.pos)) {
+            ch.pos -= needed;
+            reg.size -= needed;
+            reg.used -= needed;
             quick_freed = true;
+            if (cl->stats_id+1 == cl_stats.size()) {
+                cl_stats.pop_back();
+            } else {
+                free_stats_ids.push_back(cl->stats_id);
+            }
         }
     }
     #endif
@@ -195,9 +271,8 @@ void ClauseAllocator::clauseFree(Clause* cl)
         cl->setFreed();
         uint64_t est_num_cl = cl->size();
         est_num_cl = std::max(est_num_cl, (uint64_t)3); //we sometimes allow gauss to allocate 3-long clauses
-        uint64_t bytes_freed = sizeof(Clause) + est_num_cl*sizeof(Lit);
-        uint64_t elems_freed = bytes_freed/sizeof(BASE_DATA_TYPE) + (bool)(bytes_freed % sizeof(BASE_DATA_TYPE));
-        currentlyUsedSize -= elems_freed;
+        reg.used -= std::min(reg.used, words_needed(est_num_cl));
+        freed_stats_ids[(uint32_t)ch.region].push_back(cl->stats_id);
     }
 
     #ifdef VALGRIND_MAKE_MEM_UNDEFINED
@@ -211,88 +286,167 @@ void ClauseAllocator::clauseFree(ClOffset offset)
     clauseFree(cl);
 }
 
-ClOffset ClauseAllocator::move_cl(
-    ClOffset* newDataStart
-    , ClOffset*& new_ptr
-    , Clause* old
-) const {
-    uint64_t bytesNeeded = sizeof(Clause) + old->size()*sizeof(Lit);
-    uint64_t sizeNeeded = bytesNeeded/sizeof(BASE_DATA_TYPE) + (bool)(bytesNeeded % sizeof(BASE_DATA_TYPE));
+ClRegion ClauseAllocator::region_to_move_to(const Clause* cl) const
+{
+    if (cl->gauss_temp_cl()) {
+        return ClRegion::gauss_temp;
+    }
+    if (!cl->red()) {
+        return ClRegion::irred;
+    }
+    return red_cl_region(stats(cl).which_red_array);
+}
+
+ClOffset ClauseAllocator::move_cl(Clause* old)
+{
+    const uint64_t sizeNeeded = words_needed(old->size());
+    void* new_ptr = allocEnough(old->size(), region_to_move_to(old));
     memcpy(new_ptr, old, sizeNeeded*sizeof(BASE_DATA_TYPE));
 
-    ClOffset new_offset = new_ptr-newDataStart;
+    ClOffset new_offset = get_offset((Clause*)new_ptr);
     (*old)[0] = Lit::toLit(new_offset & 0xFFFFFFFF);
     #ifdef LARGE_OFFSETS
     (*old)[1] = Lit::toLit((new_offset>>32) & 0xFFFFFFFF);
     #endif
     old->reloced = true;
 
-    new_ptr += sizeNeeded;
     return new_offset;
 }
 
-void ClauseAllocator::move_one_watchlist(
-    watch_subarray& ws, ClOffset* newDataStart, ClOffset*& new_ptr)
+ClOffset ClauseAllocator::new_offset_of(const ClOffset offset) const
+{
+    const Clause* old = ptr(offset);
+    assert(old->reloced);
+    ClOffset new_offset = (*old)[0].toInt();
+    #ifdef LARGE_OFFSETS
+    new_offset += ((uint64_t)(*old)[1].toInt())<<32;
+    #endif
+    return new_offset;
+}
+
+void ClauseAllocator::move_one_watchlist(watch_subarray& ws)
 {
     for(Watched& w: ws) {
-        if (w.isClause()) {
+        if (w.isClause() && is_moving(w.get_offset())) {
             Clause* old = ptr(w.get_offset());
             assert(!old->freed());
             Lit blocked = w.getBlockedLit();
             if (old->reloced) {
-                ClOffset new_offset = (*old)[0].toInt();
-                #ifdef LARGE_OFFSETS
-                new_offset += ((uint64_t)(*old)[1].toInt())<<32;
-                #endif
-                w = Watched(new_offset, blocked);
+                w = Watched(new_offset_of(w.get_offset()), blocked);
             } else {
-                ClOffset new_offset = move_cl(newDataStart, new_ptr, old);
+                ClOffset new_offset = move_cl(old);
                 w = Watched(new_offset, blocked);
             }
         }
     }
 }
 
+bool ClauseAllocator::region_needs_compacting(const ClRegion region) const
+{
+    //If re-allocation is not really neccessary, don't do it
+    //Neccesities:
+    //1) There is too much empty, unused space (>20%)
+    //2) The region is not tiny
+    const Region& reg = regions[(uint32_t)region];
+    return float_div(reg.used, reg.size) <= 0.8 && reg.size >= MIN_COMPACT_SIZE;
+}
+
 /**
-@brief If needed, compacts stacks, removing unused clauses
+@brief If needed, compacts regions, removing unused clauses
 
-Firstly, the algorithm determines if the number of useless slots is large or
-small compared to the problem size. If it is small, it does nothing. If it is
-large, then it allocates new stacks, copies the non-freed clauses to these new
-stacks, updates all pointers and offsets, and frees the original stacks.
+For each region, it determines if the number of useless slots is large or
+small compared to the region's size. If it is large, it takes new chunks for
+the region, copies the non-freed clauses of the region to them, updates all
+pointers and offsets, and frees the original chunks.
 */
 void ClauseAllocator::consolidate(
     Solver* solver
     , const bool force
     , bool lower_verb
 ) {
-    //If re-allocation is not really neccessary, don't do it
-    //Neccesities:
-    //1) There is too much memory allocated. Re-allocation will save space
-    //   Avoiding segfault (max is 16 outerOffsets, more than 10 is near)
-    //2) There is too much empty, unused space (>30%)
-    if (!force
-        && (float_div(currentlyUsedSize, size) > 0.8 || currentlyUsedSize < (100ULL*1000ULL))
+    for(uint32_t i = 0; i < num_cl_regions; i++) {
+        consolidate(solver, (ClRegion)i, force, lower_verb);
+    }
+}
+
+void ClauseAllocator::consolidate(
+    Solver* solver
+    , const ClRegion region
+    , const bool force
+    , bool lower_verb
+) {
+    if (regions[(uint32_t)region].chunks.empty()
+        || (!force && !region_needs_compacting(region))
     ) {
         if (solver->conf.verbosity >= 3
             || (lower_verb && solver->conf.verbosity)
         ) {
-            cout << "c Not consolidating memory." << endl;
+            cout << "c Not consolidating memory of region "
+            << cl_region_name(region) << "." << endl;
         }
         return;
     }
-    const double myTime = cpuTime();
+    compact_region(solver, region, lower_verb);
 
-    //Pointers that will be moved along
-    BASE_DATA_TYPE * const newDataStart = (BASE_DATA_TYPE*)malloc(currentlyUsedSize*sizeof(BASE_DATA_TYPE));
-    BASE_DATA_TYPE * new_ptr = newDataStart;
+    //The clauses freed in the region are gone with its old chunks, so
+    //nothing can refer to their stats any more
+    vector<uint32_t>& freed = freed_stats_ids[(uint32_t)region];
+    free_stats_ids.insert(free_stats_ids.end(), freed.begin(), freed.end());
+    freed.clear();
 
-    assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
+    #ifndef NDEBUG
+    check_stats_ids(solver);
+    #endif
+}
 
-    vector<bool> visited(solver->watches.size(), 0);
-        for(auto& ws: solver->watches) {
-            move_one_watchlist(ws, newDataStart, new_ptr);
+#ifndef NDEBUG
+//No two clauses may share stats, and none may have stats that are free
+void ClauseAllocator::check_stats_ids(const Solver* solver) const
+{
+    vector<char> taken(cl_stats.size(), 0);
+    for(const uint32_t id: free_stats_ids) {
+        assert(id < cl_stats.size());
+        assert(!taken[id]);
+        taken[id] = 1;
+    }
+    auto check = [&](const vector<ClOffset>& offsets) {
+        for(const ClOffset offs: offsets) {
+            const Clause* cl = ptr(offs);
+            assert(cl->stats_id < cl_stats.size());
+            assert(!taken[cl->stats_id]);
+            taken[cl->stats_id] = 1;
         }
+    };
+    check(solver->longIrredCls);
+    for(const auto& lredcls: solver->longRedCls) {
+        check(lredcls);
+    }
+}
+#endif
+
+void ClauseAllocator::compact_region(
+    Solver* solver
+    , const ClRegion region
+    , bool lower_verb
+) {
+    const double myTime = cpuTime();
+    assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
+
+    //The old chunks are only read from now on, clauses are moved to new ones
+    Region& reg = regions[(uint32_t)region];
+    const uint64_t old_size = reg.size;
+    vector<uint32_t> old_chunks;
+    old_chunks.swap(reg.chunks);
+    for(const uint32_t at: old_chunks) {
+        chunks[at].moving = true;
+    }
+    reg.cur_chunk = std::numeric_limits<uint32_t>::max();
+    reg.size = 0;
+    reg.used = 0;
+
+    for(auto& ws: solver->watches) {
+        move_one_watchlist(ws);
+    }
 
     #ifdef USE_GAUSS
     for (EGaussian* gauss : solver->gmatrices) {
@@ -301,16 +455,14 @@ void ClauseAllocator::consolidate(
         }
 
         for(auto& gcl: gauss->clauses_toclear) {
+            if (!is_moving(gcl.first)) {
+                continue;
+            }
             Clause* old = ptr(gcl.first);
             if (old->reloced) {
-                ClOffset new_offset = (*old)[0].toInt();
-                #ifdef LARGE_OFFSETS
-                new_offset += ((uint64_t)(*old)[1].toInt())<<32;
-                #endif
-                gcl.first = new_offset;
+                gcl.first = new_offset_of(gcl.first);
             } else {
-                ClOffset new_offset = move_cl(newDataStart, new_ptr, old);
-                gcl.first = new_offset;
+                gcl.first = move_cl(old);
             }
             assert(!old->freed());
         }
@@ -325,7 +477,7 @@ void ClauseAllocator::consolidate(
     //Fix up propBy
     for (size_t i = 0; i < solver->nVars(); i++) {
         VarData& vdata = solver->varData[i];
-        if (vdata.reason.isClause()) {
+        if (vdata.reason.isClause() && is_moving(vdata.reason.get_offset())) {
             if (vdata.removed == Removed::none
                 && solver->decisionLevel() >= vdata.level
                 && vdata.level != 0
@@ -333,38 +485,25 @@ void ClauseAllocator::consolidate(
             ) {
                 Clause* old = ptr(vdata.reason.get_offset());
                 assert(!old->freed());
-                ClOffset new_offset = (*old)[0].toInt();
-                #ifdef LARGE_OFFSETS
-                new_offset += ((uint64_t)(*old)[1].toInt())<<32;
-                #endif
-                vdata.reason = PropBy(new_offset);
+                vdata.reason = PropBy(new_offset_of(vdata.reason.get_offset()));
             } else {
                 vdata.reason = PropBy();
             }
         }
     }
 
-    //Update sizes
-    const uint64_t old_size = size;
-    size = new_ptr-newDataStart;
-    capacity = currentlyUsedSize;
-    currentlyUsedSize = size;
-    free(dataStart);
-    dataStart = newDataStart;
+    for(const uint32_t at: old_chunks) {
+        free_chunk(at);
+    }
 
     const double time_used = cpuTime() - myTime;
     if (solver->conf.verbosity >= 2
         || (lower_verb && solver->conf.verbosity)
     ) {
-        size_t log_2_size = 0;
-        if (size > 0) {
-            //yes, it can be 0 (only binary clauses, for example)
-            log_2_size = std::log2(size);
-        }
-        cout << "c [mem] consolidate ";
+        cout << "c [mem] consolidate " << cl_region_name(region);
         cout << " old-sz: " << print_value_kilo_mega(old_size*sizeof(BASE_DATA_TYPE))
-        << " new-sz: " << print_value_kilo_mega(size*sizeof(BASE_DATA_TYPE))
-        << " new bits offs: " << std::fixed << std::setprecision(2) << log_2_size;
+        << " new-sz: " << print_value_kilo_mega(reg.size*sizeof(BASE_DATA_TYPE))
+        << " chunks: " << (chunks.size() - free_chunks.size());
         cout << solver->conf.print_times(time_used)
         << endl;
     }
@@ -375,19 +514,19 @@ void ClauseAllocator::update_offsets(
 ) {
 
     for(ClOffset& offs: offsets) {
-        Clause* old = ptr(offs);
-        assert(old->reloced);
-        offs = (*old)[0].toInt();
-        #ifdef LARGE_OFFSETS
-        offs += ((uint64_t)(*old)[1].toInt())<<32;
-        #endif
+        if (is_moving(offs)) {
+            offs = new_offset_of(offs);
+        }
     }
 }
 
 size_t ClauseAllocator::mem_used() const
 {
     uint64_t mem = 0;
-    mem += capacity*sizeof(BASE_DATA_TYPE);
+    for(const Chunk& ch: chunks) {
+        mem += ch.capacity*sizeof(BASE_DATA_TYPE);
+    }
+    mem += cl_stats.capacity()*sizeof(ClauseStats);
 
     return mem;
 }
@@ -29,9 +29,12 @@ THE SOFTWARE.
 #include "watched.h"
 #include "clause.h"
 #include "watcharray.h"
+#include "hugealloc.h"
 
 #include <stdlib.h>
+#include <limits>
 #include <map>
+#include <string>
 #include <vector>
 
 namespace CMSGen {
@@ -43,14 +46,53 @@ class PropEngine;
 using std::map;
 using std::vector;
 
+///Which part of the clause arena a clause lives in
+enum class ClRegion : uint8_t {
+    irred = 0
+    , red0 = 1 ///<redundant, which_red_array == 0
+    , red1 = 2
+    , red2 = 3
+    , gauss_temp = 4 ///<temporary reasons of Gauss-Jordan propagations
+};
+static const uint32_t num_cl_regions = 5;
+
+inline ClRegion red_cl_region(const uint32_t which_red_array)
+{
+    return (ClRegion)((uint32_t)ClRegion::red0 + which_red_array);
+}
+
+inline std::string cl_region_name(const ClRegion r)
+{
+    switch(r) {
+        case ClRegion::irred:
+            return "irred";
+        case ClRegion::red0:
+            return "red0";
+        case ClRegion::red1:
+            return "red1";
+        case ClRegion::red2:
+            return "red2";
+        case ClRegion::gauss_temp:
+            return "gauss";
+    }
+    return "unknown";
+}
+
 /**
 @brief Allocates memory for (xor) clauses
 
-This class allocates memory in large chunks, then distributes it to clauses when
-needed. When instructed, it consolidates the unused space (i.e. clauses free()-ed).
-Essentially, it is a stack-like allocator for clauses. It is useful to have
-this, because this way, we can address clauses according to their number,
-which is 32-bit, instead of their address, which might be 64-bit
+This class allocates memory in fixed-size chunks, then distributes it to clauses
+when needed. Irredundant clauses, each tier of redundant clauses and Gauss
+temporaries each get their own chunks (their own "region"), and each region is
+compacted on its own when it has too much unused space (i.e. clauses free()-ed),
+so cleaning e.g. the redundant clauses of tier 2 only moves those. Growing
+never moves clauses, it just takes a new chunk.
+
+Clauses are addressed according to their number, which is 32-bit, instead of
+their address, which might be 64-bit: the top bits of the offset are the index
+of the chunk's slot, the rest is the position inside the chunk. Chunks are
+aligned to their size and start with their slot number, so the offset of a
+clause can also be found from its address.
 */
 class ClauseAllocator {
     public:
@@ -58,14 +100,26 @@ class ClauseAllocator {
         ~ClauseAllocator();
 
         template<class T>
-        Clause* Clause_new(const T& ps, const uint32_t conflictNum
-        ) {
+        Clause* Clause_new(const T& ps, const uint32_t conflictNum, const ClRegion region)
+        {
             if (ps.size() > (0x01UL << 28)) {
                 throw CMSGen::TooLongClauseError();
             }
 
-            void* mem = allocEnough(ps.size());
-            Clause* real = new (mem) Clause(ps, conflictNum);
+            void* mem = allocEnough(ps.size(), region);
+            uint32_t stats_id;
+            if (free_stats_ids.empty()) {
+                stats_id = cl_stats.size();
+                cl_stats.push_back(ClauseStats());
+            } else {
+                stats_id = free_stats_ids.back();
+                free_stats_ids.pop_back();
+                cl_stats[stats_id] = ClauseStats();
+            }
+            Clause* real = new (mem) Clause(ps, stats_id);
+            ClauseStats& st = cl_stats[stats_id];
+            st.last_touched = conflictNum;
+            st.glue = std::min<uint32_t>(st.glue, ps.size());
 
             return real;
         }
@@ -74,50 +128,125 @@ class ClauseAllocator {
 
         inline Clause* ptr(const ClOffset offset) const
         {
-            return (Clause*)(&dataStart[offset]);
+            return (Clause*)(slot_start[offset >> chunk_bits] + (offset & chunk_mask));
+        }
+
+        inline ClauseStats& stats(const Clause* cl)
+        {
+            return cl_stats[cl->stats_id];
+        }
+
+        inline const ClauseStats& stats(const Clause* cl) const
+        {
+            return cl_stats[cl->stats_id];
+        }
+
+        inline ClauseStats& stats(const Clause& cl)
+        {
+            return cl_stats[cl.stats_id];
+        }
+
+        inline const ClauseStats& stats(const Clause& cl) const
+        {
+            return cl_stats[cl.stats_id];
         }
 
         void clauseFree(Clause* c);
         void clauseFree(ClOffset offset);
 
+        //Compacts the regions that have too much unused space (all if force)
+        void consolidate(
+            Solver* solver
+            , const bool force = false
+            , bool lower_verb = false
+        );
+        //Compacts only one region, if it has too much unused space
         void consolidate(
             Solver* solver
+            , const ClRegion region
             , const bool force = false
             , bool lower_verb = false
         );
 
         size_t mem_used() const;
 
+        ///Backing memory of the chunks, see SolverConf::huge_pages
+        void set_huge_pages(const HugePages mode);
+        HugePages get_huge_pages() const
+        {
+            return huge_pages;
+        }
+
     private:
+        //2MB chunks. A slot is the part of the offset space one chunk takes up
+        static const size_t chunk_bytes = 2ULL << 20;
+        static const uint32_t chunk_bits = sizeof(BASE_DATA_TYPE) == 4 ? 19 : 18;
+        static const uint64_t chunk_mask = (1ULL << chunk_bits) - 1;
+        static const uint64_t max_slots = (1ULL << EFFECTIVELY_USEABLE_BITS) >> chunk_bits;
+
+        struct Chunk {
+            BASE_DATA_TYPE* mem = NULL; ///<mem[0] is the first slot, clauses follow
+            uint64_t capacity = 0; ///<In BASE_DATA_TYPE units
+            uint64_t pos = 0; ///<Next free position
+            uint32_t first_slot = 0;
+            uint32_t num_slots = 0; ///<More than 1 for a clause that doesn't fit a chunk
+            ClRegion region = ClRegion::irred;
+            bool moving = false; ///<Its region is being compacted
+        };
+
+        struct Region {
+            vector<uint32_t> chunks;
+            uint32_t cur_chunk = std::numeric_limits<uint32_t>::max();
+            uint64_t size = 0; ///<The number of BASE_DATA_TYPE datapieces handed out
+            /**
+            @brief The estimated used size of the region
+            This is incremented by clauseSize each time a clause is allocated, and
+            decremetented by clauseSize each time a clause is deallocated. The
+            problem is, that clauses can shrink, and thus this value will be an
+            overestimation almost all the time
+            */
+            uint64_t used = 0;
+        };
+
+        static uint64_t words_needed(const uint64_t num_lits);
+        uint32_t chunk_of(const Clause* cl) const;
+        bool region_needs_compacting(const ClRegion region) const;
+        uint32_t new_chunk(const ClRegion region, const uint64_t words);
+        void free_chunk(const uint32_t at);
+        void compact_region(Solver* solver, const ClRegion region, bool lower_verb);
+        ClRegion region_to_move_to(const Clause* cl) const;
+        bool is_moving(const ClOffset offset) const
+        {
+            const uint32_t at = slot_chunk[offset >> chunk_bits];
+            return at != std::numeric_limits<uint32_t>::max() && chunks[at].moving;
+        }
+        ClOffset new_offset_of(const ClOffset offset) const;
         void update_offsets(vector<ClOffset>& offsets);
-        void move_one_watchlist(
-            watch_subarray& ws, ClOffset* newDataStart, ClOffset*& new_ptr);
+        void move_one_watchlist(watch_subarray& ws);
+        ClOffset move_cl(Clause* old);
 
-        ClOffset move_cl(
-            ClOffset* newDataStart
-            , ClOffset*& new_ptr
-            , Clause* old
-        ) const;
+        HugePages huge_pages = HugePages::none;
+        vector<Chunk> chunks;
+        vector<uint32_t> free_chunks; ///<Unused entries of "chunks"
+        Region regions[num_cl_regions];
+        vector<BASE_DATA_TYPE*> slot_start; ///<Where offsets of a slot point to
+        vector<uint32_t> slot_chunk; ///<Which chunk has the slot, or UINT32_MAX
+
+        void* allocEnough(const uint32_t num_lits, const ClRegion region);
 
-        BASE_DATA_TYPE* dataStart; ///<Stack starts at these positions
-        uint64_t size; ///<The number of BASE_DATA_TYPE datapieces currently used in each stack
-        /**
-        @brief Clauses in the stack had this size when they were allocated
-        This my NOT be their current size: the clauses may be shrinked during
-        the running of the solver. Therefore, it is imperative that their orignal
-        size is saved. This way, we can later move clauses around.
-        */
-        uint64_t capacity; ///<The number of BASE_DATA_TYPE datapieces allocated
         /**
-        @brief The estimated used size of the stack
-        This is incremented by clauseSize each time a clause is allocated, and
-        decremetented by clauseSize each time a clause is deallocated. The
-        problem is, that clauses can shrink, and thus this value will be an
-        overestimation almost all the time
+        @brief Statistics of the clauses, indexed by Clause::stats_id
+        Kept out of the clauses so that the arena only holds what propagation
+        reads. A freed clause stays in its chunk, and may still be looked at,
+        until its region is compacted. So its slot is only reused after that,
+        until then it waits in freed_stats_ids of its region.
         */
-        uint64_t currentlyUsedSize;
-
-        void* allocEnough(const uint32_t num_lits);
+        vector<ClauseStats> cl_stats;
+        vector<uint32_t> freed_stats_ids[num_cl_regions];
+        vector<uint32_t> free_stats_ids;
+        #ifndef NDEBUG
+        void check_stats_ids(const Solver* solver) const;
+        #endif
 };
 
 } //end namespace
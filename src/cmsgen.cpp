@@ -29,10 +29,17 @@ THE SOFTWARE.
 
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cstring>
 #include <atomic>
 using std::thread;
 
 #define CACHE_SIZE 10ULL*1000ULL*1000UL
+#define MAX_QUEUED_SAMPLES 256
+#define MAX_CUBE_VARS 10
+#define CUBE_VAR_PICK_PROBES 64
+#define CUBE_PROBES_PER_CUBE 32
 #ifndef LIMITMEM
 #define MAX_VARS (1ULL<<28)
 #else
@@ -163,6 +170,7 @@ struct OneThreadAddCls
         solver.new_external_vars(data_for_thread.vars_to_add);
 
         vector<Lit> lits;
+        vector<size_t> offsets;
         vector<uint32_t> vars;
         bool ret = true;
         size_t at = 0;
@@ -170,16 +178,22 @@ struct OneThreadAddCls
         const size_t size = orig_lits.size();
         while(at < size && ret) {
             if (orig_lits[at] == lit_Undef) {
+                //Consecutive clauses are added in one go
                 lits.clear();
-                at++;
-                for(; at < size
-                    && orig_lits[at] != lit_Undef
-                    && orig_lits[at] != lit_Error
-                    ; at++
-                ) {
-                    lits.push_back(orig_lits[at]);
+                offsets.clear();
+                while(at < size && orig_lits[at] == lit_Undef) {
+                    offsets.push_back(lits.size());
+                    at++;
+                    for(; at < size
+                        && orig_lits[at] != lit_Undef
+                        && orig_lits[at] != lit_Error
+                        ; at++
+                    ) {
+                        lits.push_back(orig_lits[at]);
+                    }
                 }
-                ret = solver.add_clause_outer(lits);
+                offsets.push_back(lits.size());
+                ret = solver.add_clauses_outer(lits, offsets);
             } else {
                 vars.clear();
                 at++;
@@ -270,6 +284,35 @@ DLL_PUBLIC void SATSolver::set_no_simplify()
     }
 }
 
+DLL_PUBLIC void SATSolver::set_num_threads(const unsigned num)
+{
+    if (num == 0) {
+        std::cerr << "ERROR: Number of threads must be at least 1" << endl;
+        exit(-1);
+    }
+    if (num == 1) {
+        return;
+    }
+
+    if (data->solvers[0]->nVarsOutside() > 0 || data->vars_to_add > 0) {
+        std::cerr << "ERROR: You must call set_num_threads() BEFORE adding variables" << endl;
+        exit(-1);
+    }
+
+    if (data->solvers.size() > 1) {
+        std::cerr << "ERROR: You must call set_num_threads() at most once" << endl;
+        exit(-1);
+    }
+
+    for(unsigned i = 1; i < num; i++) {
+        SolverConf conf = data->solvers[0]->getConf();
+        conf.origSeed += i;
+        conf.verbosity = 0;
+        data->solvers.push_back(new Solver(&conf, data->must_interrupt));
+        data->cpu_times.push_back(0.0);
+    }
+}
+
 DLL_PUBLIC void SATSolver::set_allow_otf_gauss()
 {
     #ifndef USE_GAUSS
@@ -311,6 +354,41 @@ DLL_PUBLIC void SATSolver::set_sampling_vars(vector<uint32_t>* sampl_vars)
     }
 }
 
+DLL_PUBLIC void SATSolver::set_sample_continue(bool cont)
+{
+    for (size_t i = 0; i < data->solvers.size(); ++i) {
+        Solver& s = *data->solvers[i];
+        s.conf.sample_continue = cont;
+    }
+}
+
+DLL_PUBLIC void SATSolver::set_var_elim(bool elim, unsigned threads)
+{
+    for (size_t i = 0; i < data->solvers.size(); ++i) {
+        Solver& s = *data->solvers[i];
+        s.conf.doVarElim = elim;
+        s.conf.do_empty_varelim = elim;
+        s.conf.bve_threads = std::max(1U, threads);
+    }
+}
+
+DLL_PUBLIC void SATSolver::set_subsume_threads(unsigned threads)
+{
+    for (size_t i = 0; i < data->solvers.size(); ++i) {
+        Solver& s = *data->solvers[i];
+        s.conf.subsume_threads = std::max(1U, threads);
+    }
+}
+
+DLL_PUBLIC void SATSolver::set_find_xors(bool find, unsigned threads)
+{
+    for (size_t i = 0; i < data->solvers.size(); ++i) {
+        Solver& s = *data->solvers[i];
+        s.conf.doFindXors = find;
+        s.conf.xor_find_threads = std::max(1U, threads);
+    }
+}
+
 DLL_PUBLIC void SATSolver::set_verbosity(unsigned verbosity)
 {
     if (data->solvers.empty())
@@ -348,6 +426,38 @@ DLL_PUBLIC bool SATSolver::add_clause(const vector< Lit >& lits)
     return ret;
 }
 
+DLL_PUBLIC bool SATSolver::add_clauses(
+    const vector<Lit>& lits
+    , const vector<size_t>& offsets
+) {
+    bool ret = true;
+    if (offsets.size() < 2) {
+        return ret;
+    }
+    assert(offsets.back() <= lits.size());
+
+    if (data->solvers.size() > 1) {
+        for(size_t i = 0; i+1 < offsets.size(); i++) {
+            const size_t sz = offsets[i+1] - offsets[i];
+            if (data->cls_lits.size() + sz + 1 > CACHE_SIZE) {
+                ret &= actually_add_clauses_to_threads(data);
+            }
+
+            data->cls_lits.push_back(lit_Undef);
+            data->cls_lits.insert(data->cls_lits.end()
+                , lits.begin() + offsets[i], lits.begin() + offsets[i+1]);
+        }
+    } else {
+        data->solvers[0]->new_vars(data->vars_to_add);
+        data->vars_to_add = 0;
+
+        ret = data->solvers[0]->add_clauses_outer(lits, offsets);
+        data->cls += offsets.size()-1;
+    }
+
+    return ret;
+}
+
 DLL_PUBLIC bool SATSolver::add_xor_clause(const std::vector<unsigned>& vars, bool rhs)
 {
     bool ret = true;
@@ -434,11 +544,8 @@ struct OneThreadCalc
     bool only_sampling_solution;
 };
 
-lbool calc(
-    const vector< Lit >* assumptions,
-    bool solve, CMSatPrivateData *data,
-    bool only_sampling_solution = false
-) {
+static void reset_interrupt_and_set_timeout(CMSatPrivateData *data)
+{
     //Reset the interrupt signal if it was set
     data->must_interrupt->store(false, std::memory_order_relaxed);
 
@@ -449,6 +556,14 @@ lbool calc(
             s.conf.maxTime = cpuTime() + data->timeout;
         }
     }
+}
+
+lbool calc(
+    const vector< Lit >* assumptions,
+    bool solve, CMSatPrivateData *data,
+    bool only_sampling_solution = false
+) {
+    reset_interrupt_and_set_timeout(data);
 
     if (data->solvers.size() > 1 && data->sql > 0) {
         std::cerr
@@ -508,6 +623,546 @@ DLL_PUBLIC lbool SATSolver::solve(const vector< Lit >* assumptions, bool only_sa
     return calc(assumptions, true, data, only_sampling_solution);
 }
 
+struct SampleQueue
+{
+    std::mutex mu;
+    std::condition_variable cv;
+    std::deque<vector<lbool> > models;
+    bool finished = false;
+    bool stop = false;
+    lbool ret = l_True;
+};
+
+//Generate "num" samples under "assumptions"
+struct SampleJob
+{
+    vector<Lit> assumptions;
+    uint64_t num = 0;
+};
+
+static uint64_t num_samples_in(const vector<SampleJob>& jobs)
+{
+    uint64_t num = 0;
+    for(const SampleJob& job: jobs) {
+        num += job.num;
+    }
+    return num;
+}
+
+struct OneThreadSample
+{
+    OneThreadSample(
+        DataForThread& _data_for_thread,
+        size_t _tid,
+        const vector<SampleJob>& _jobs,
+        SampleQueue& _queue,
+        bool _only_sampling_solution
+    ) :
+        data_for_thread(_data_for_thread)
+        , tid(_tid)
+        , jobs(_jobs)
+        , queue(_queue)
+        , only_sampling_solution(_only_sampling_solution)
+    {}
+
+    void operator()()
+    {
+        OneThreadAddCls cls_adder(data_for_thread, tid);
+        cls_adder();
+
+        Solver& solver = *data_for_thread.solvers[tid];
+        lbool ret = solver.okay() ? l_True : l_False;
+        for(const SampleJob& job: jobs) {
+            if (job.num == 0) {
+                continue;
+            }
+            if (ret != l_True) {
+                break;
+            }
+            {
+                std::lock_guard<std::mutex> lock(queue.mu);
+                if (queue.stop) {
+                    break;
+                }
+            }
+            ret = solver.sample_with_assumptions(
+                &job.assumptions
+                , only_sampling_solution
+                , job.num
+                , [&](const vector<lbool>& model) {
+                    std::unique_lock<std::mutex> lock(queue.mu);
+                    queue.cv.wait(lock, [&]{
+                        return queue.stop || queue.models.size() < MAX_QUEUED_SAMPLES;});
+                    if (queue.stop) {
+                        return false;
+                    }
+                    queue.models.push_back(model);
+                    lock.unlock();
+                    queue.cv.notify_all();
+                    return true;
+                }
+            );
+        }
+        data_for_thread.cpu_times[tid] = cpuTime();
+
+        std::lock_guard<std::mutex> lock(queue.mu);
+        queue.finished = true;
+        queue.ret = ret;
+        queue.cv.notify_all();
+    }
+
+    DataForThread& data_for_thread;
+    const size_t tid;
+    const vector<SampleJob>& jobs;
+    SampleQueue& queue;
+    bool only_sampling_solution;
+};
+
+//Thread i runs jobs[i]. Samples are collected round-robin over the threads
+//that still have samples to give, so the output is reproducible.
+static lbool sample_jobs_threaded(
+    CMSatPrivateData *data
+    , const vector<vector<SampleJob> >& jobs
+    , std::function<bool(const vector<lbool>& model)>& callback
+    , bool only_sampling_solution
+) {
+    const size_t num_threads = data->solvers.size();
+    assert(jobs.size() == num_threads);
+    DataForThread data_for_thread(data);
+    vector<SampleQueue> queues(num_threads);
+    vector<uint64_t> left(num_threads);
+    uint64_t num_samples = 0;
+    std::vector<std::thread> thds;
+    for(size_t i = 0; i < num_threads; i++) {
+        left[i] = num_samples_in(jobs[i]);
+        num_samples += left[i];
+        thds.push_back(thread(OneThreadSample(
+            data_for_thread, i, jobs[i], queues[i], only_sampling_solution)));
+    }
+
+    lbool ret = l_True;
+    bool stop = false;
+    size_t at = 0;
+    for(uint64_t i = 0; i < num_samples && !stop; i++) {
+        while(left[at] == 0) {
+            at = (at+1) % num_threads;
+        }
+        SampleQueue& q = queues[at];
+        left[at]--;
+        at = (at+1) % num_threads;
+
+        std::unique_lock<std::mutex> lock(q.mu);
+        q.cv.wait(lock, [&]{return !q.models.empty() || q.finished;});
+        if (q.models.empty()) {
+            ret = q.ret;
+            stop = true;
+            break;
+        }
+        vector<lbool> model = std::move(q.models.front());
+        q.models.pop_front();
+        lock.unlock();
+        q.cv.notify_all();
+
+        stop = !callback(model);
+    }
+
+    if (stop) {
+        data->must_interrupt->store(true, std::memory_order_relaxed);
+        for(SampleQueue& q: queues) {
+            std::lock_guard<std::mutex> lock(q.mu);
+            q.stop = true;
+            q.cv.notify_all();
+        }
+    }
+    for(std::thread& thread : thds){
+        thread.join();
+    }
+    data->must_interrupt->store(false, std::memory_order_relaxed);
+
+    //clear what has been added
+    data->cls_lits.clear();
+    data->vars_to_add = 0;
+    data->okay = true;
+    for(const Solver* s: data->solvers) {
+        data->okay &= s->okay();
+    }
+
+    return ret;
+}
+
+static lbool sample_threaded(
+    CMSatPrivateData *data
+    , uint64_t num_samples
+    , std::function<bool(const vector<lbool>& model)>& callback
+    , const vector<Lit>* assumptions
+    , bool only_sampling_solution
+) {
+    //Thread i generates samples i, i+T, i+2T, ...
+    const size_t num_threads = data->solvers.size();
+    vector<vector<SampleJob> > jobs(num_threads, vector<SampleJob>(1));
+    for(size_t i = 0; i < num_threads; i++) {
+        if (assumptions) {
+            jobs[i][0].assumptions = *assumptions;
+        }
+        jobs[i][0].num = num_samples/num_threads + (i < num_samples%num_threads);
+    }
+
+    return sample_jobs_threaded(data, jobs, callback, only_sampling_solution);
+}
+
+DLL_PUBLIC lbool SATSolver::sample(
+    uint64_t num_samples
+    , std::function<bool(const std::vector<lbool>& model)> callback
+    , const vector<Lit>* assumptions
+    , bool only_sampling_solution
+) {
+    if (num_samples == 0) {
+        return l_Undef;
+    }
+
+    data->num_solve_simplify_calls++;
+    data->previous_sum_conflicts = get_sum_conflicts();
+    data->previous_sum_propagations = get_sum_propagations();
+    data->previous_sum_decisions = get_sum_decisions();
+    reset_interrupt_and_set_timeout(data);
+
+    if (data->solvers.size() > 1) {
+        return sample_threaded(
+            data, num_samples, callback, assumptions, only_sampling_solution);
+    }
+
+    data->solvers[0]->new_vars(data->vars_to_add);
+    data->vars_to_add = 0;
+    data->which_solved = 0;
+    lbool ret = data->solvers[0]->sample_with_assumptions(
+        assumptions, only_sampling_solution, num_samples, callback);
+    data->okay = data->solvers[0]->okay();
+    data->cpu_times[0] = cpuTime();
+    return ret;
+}
+
+//Picks the vars that are closest to a 50-50 split in some probe samples,
+//so the cubes are as even as possible. Vars never seen set are skipped.
+static vector<uint32_t> pick_cube_vars(
+    SATSolver* solver
+    , uint32_t num_cube_vars
+    , const vector<uint32_t>& candidates
+    , const vector<Lit>* assumptions
+    , bool only_sampling_solution
+) {
+    vector<uint64_t> num_true(candidates.size(), 0);
+    vector<uint64_t> num_set(candidates.size(), 0);
+    lbool ret = solver->sample(
+        CUBE_VAR_PICK_PROBES
+        , [&](const vector<lbool>& model) {
+            for(size_t i = 0; i < candidates.size(); i++) {
+                const lbool val = model[candidates[i]];
+                num_set[i] += val != l_Undef;
+                num_true[i] += val == l_True;
+            }
+            return true;
+        }
+        , assumptions
+        , only_sampling_solution
+    );
+    if (ret != l_True) {
+        return vector<uint32_t>();
+    }
+
+    vector<std::pair<uint64_t, size_t> > by_balance;
+    for(size_t i = 0; i < candidates.size(); i++) {
+        if (num_set[i] != CUBE_VAR_PICK_PROBES
+            || num_true[i] == 0
+            || num_true[i] == CUBE_VAR_PICK_PROBES
+        ) {
+            continue;
+        }
+        const uint64_t twice_true = 2*num_true[i];
+        const uint64_t off = twice_true > CUBE_VAR_PICK_PROBES ?
+            twice_true - CUBE_VAR_PICK_PROBES : CUBE_VAR_PICK_PROBES - twice_true;
+        by_balance.push_back(std::make_pair(off, i));
+    }
+    std::sort(by_balance.begin(), by_balance.end());
+
+    vector<uint32_t> cube_vars;
+    for(size_t i = 0; i < by_balance.size() && cube_vars.size() < num_cube_vars; i++) {
+        cube_vars.push_back(candidates[by_balance[i].second]);
+    }
+    return cube_vars;
+}
+
+DLL_PUBLIC lbool SATSolver::sample_cubes(
+    uint64_t num_samples
+    , std::function<bool(const std::vector<lbool>& model)> callback
+    , uint32_t num_cube_vars
+    , const std::vector<uint32_t>* cube_vars_given
+    , const vector<Lit>* assumptions
+    , bool only_sampling_solution
+) {
+    const size_t num_threads = data->solvers.size();
+    if (num_samples == 0) {
+        return l_Undef;
+    }
+    if (cube_vars_given == NULL && num_cube_vars == 0) {
+        if (num_threads == 1) {
+            return sample(num_samples, callback, assumptions, only_sampling_solution);
+        }
+        //A few cubes per thread, so uneven cubes can be balanced
+        while((1ULL << num_cube_vars) < 4*num_threads) {
+            num_cube_vars++;
+        }
+    }
+
+    vector<uint32_t> cube_vars;
+    if (cube_vars_given) {
+        for(const uint32_t var: *cube_vars_given) {
+            if (var >= nVars()) {
+                std::cerr << "ERROR: Cube variable " << var+1
+                << " is too large, there are only "
+                << nVars() << " variables" << endl;
+                exit(-1);
+            }
+        }
+        //Vars outside the sampling set are unset in such solutions, so
+        //every solution would fall into the same cube
+        const vector<uint32_t>* sampling_vars = data->solvers[0]->conf.sampling_vars;
+        if (only_sampling_solution && sampling_vars) {
+            vector<char> sampling(nVars(), 0);
+            for(const uint32_t var: *sampling_vars) {
+                sampling[var] = 1;
+            }
+            for(const uint32_t var: *cube_vars_given) {
+                if (!sampling[var]) {
+                    std::cerr << "ERROR: Cube variable " << var+1
+                    << " is not a sampling variable, but only the sampling"
+                    << " variables are requested in the solution" << endl;
+                    exit(-1);
+                }
+            }
+        }
+        cube_vars = *cube_vars_given;
+        if (cube_vars.size() > MAX_CUBE_VARS) {
+            cube_vars.resize(MAX_CUBE_VARS);
+        }
+    } else {
+        //Candidates: the sampling vars, else the vars of the XORs, else all
+        num_cube_vars = std::min<uint32_t>(num_cube_vars, MAX_CUBE_VARS);
+        vector<uint32_t> candidates;
+        const vector<uint32_t>* sampling_vars = data->solvers[0]->conf.sampling_vars;
+        if (sampling_vars && !sampling_vars->empty()) {
+            candidates = *sampling_vars;
+        } else if (!only_sampling_solution) {
+            vector<char> seen(nVars(), 0);
+            for(const auto& x: get_recovered_xors(false)) {
+                for(const uint32_t var: x.first) {
+                    if (var < nVars() && !seen[var]) {
+                        seen[var] = 1;
+                        candidates.push_back(var);
+                    }
+                }
+            }
+            if (candidates.empty()) {
+                for(uint32_t i = 0; i < nVars(); i++) {
+                    candidates.push_back(i);
+                }
+            }
+        }
+        cube_vars = pick_cube_vars(
+            this, num_cube_vars, candidates, assumptions, only_sampling_solution);
+    }
+    if (cube_vars.empty()) {
+        return sample(num_samples, callback, assumptions, only_sampling_solution);
+    }
+
+    //Estimate the share of each cube by how often probe samples fall into it
+    const size_t num_cubes = 1ULL << cube_vars.size();
+    const uint64_t num_probes = CUBE_PROBES_PER_CUBE*num_cubes;
+    vector<uint64_t> hits(num_cubes, 0);
+    lbool ret = sample(
+        num_probes
+        , [&](const vector<lbool>& model) {
+            size_t cube = 0;
+            for(size_t i = 0; i < cube_vars.size(); i++) {
+                cube |= (size_t)(model[cube_vars[i]] == l_True) << i;
+            }
+            hits[cube]++;
+            return true;
+        }
+        , assumptions
+        , only_sampling_solution
+    );
+    if (ret != l_True) {
+        return ret;
+    }
+
+    auto cube_assumptions = [&](size_t c) {
+        vector<Lit> assumps;
+        if (assumptions) {
+            assumps = *assumptions;
+        }
+        for(size_t i = 0; i < cube_vars.size(); i++) {
+            assumps.push_back(Lit(cube_vars[i], !((c >> i) & 1)));
+        }
+        return assumps;
+    };
+
+    //Cubes the probes missed may still have solutions. If they got no
+    //samples, that part of the space could never be returned. So every
+    //satisfiable cube gets one extra hit, and its share can't be zero
+    vector<uint64_t> weight(num_cubes, 0);
+    uint64_t total_weight = 0;
+    for(size_t c = 0; c < num_cubes; c++) {
+        if (hits[c] == 0) {
+            const vector<Lit> assumps = cube_assumptions(c);
+            if (solve(&assumps, only_sampling_solution) != l_True) {
+                continue;
+            }
+        }
+        weight[c] = hits[c] + 1;
+        total_weight += weight[c];
+    }
+
+    //Proportional split, the remainder goes to the largest fractions.
+    //num_samples*weight[c] may overflow, so split num_samples first
+    const uint64_t per_weight = num_samples / total_weight;
+    const uint64_t rest = num_samples % total_weight;
+    vector<uint64_t> num_in_cube(num_cubes);
+    vector<std::pair<uint64_t, size_t> > by_remainder;
+    uint64_t given = 0;
+    for(size_t c = 0; c < num_cubes; c++) {
+        //Can't overflow: rest < total_weight <= num_probes+num_cubes
+        const uint64_t rest_share = rest * weight[c];
+        num_in_cube[c] = per_weight * weight[c] + rest_share / total_weight;
+        given += num_in_cube[c];
+        if (weight[c] > 0) {
+            by_remainder.push_back(std::make_pair(rest_share % total_weight, c));
+        }
+    }
+    std::stable_sort(by_remainder.begin(), by_remainder.end(),
+        [](const std::pair<uint64_t, size_t>& a, const std::pair<uint64_t, size_t>& b) {
+            return a.first > b.first;
+        });
+    for(size_t i = 0; given < num_samples; i++) {
+        num_in_cube[by_remainder[i % by_remainder.size()].second]++;
+        given++;
+    }
+
+    //Largest cube first, to the thread with the least work so far
+    vector<size_t> order;
+    for(size_t c = 0; c < num_cubes; c++) {
+        if (num_in_cube[c] > 0) {
+            order.push_back(c);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return num_in_cube[a] > num_in_cube[b];
+    });
+    vector<vector<SampleJob> > jobs(num_threads);
+    vector<uint64_t> load(num_threads, 0);
+    for(const size_t c: order) {
+        const size_t t = std::min_element(load.begin(), load.end()) - load.begin();
+        SampleJob job;
+        job.assumptions = cube_assumptions(c);
+        job.num = num_in_cube[c];
+        load[t] += job.num;
+        jobs[t].push_back(job);
+    }
+
+    if (num_threads > 1) {
+        data->num_solve_simplify_calls++;
+        reset_interrupt_and_set_timeout(data);
+        return sample_jobs_threaded(data, jobs, callback, only_sampling_solution);
+    }
+
+    bool stop = false;
+    std::function<bool(const vector<lbool>& model)> cb =
+        [&](const vector<lbool>& model) {
+            stop = !callback(model);
+            return !stop;
+        };
+    for(const SampleJob& job: jobs[0]) {
+        ret = sample(job.num, cb, &job.assumptions, only_sampling_solution);
+        if (ret != l_True || stop) {
+            break;
+        }
+    }
+    return ret;
+}
+
+DLL_PUBLIC lbool SATSolver::sample_parallel(
+    uint32_t num_samples
+    , std::function<void(const std::vector<lbool>& model)> callback
+    , const vector<Lit>* assumptions
+    , bool only_sampling_solution
+) {
+    return sample(
+        num_samples
+        , [&](const vector<lbool>& model) {
+            callback(model);
+            return true;
+        }
+        , assumptions
+        , only_sampling_solution
+    );
+}
+
+DLL_PUBLIC size_t SATSolver::get_sample_bytes(size_t num_vars)
+{
+    return (num_vars+7)/8;
+}
+
+DLL_PUBLIC void SATSolver::pack_sample(
+    const std::vector<lbool>& model
+    , const std::vector<uint32_t>* vars
+    , uint8_t* out)
+{
+    const size_t num = vars ? vars->size() : model.size();
+    memset(out, 0, get_sample_bytes(num));
+    for(size_t i = 0; i < num; i++) {
+        const uint32_t var = vars ? (*vars)[i] : i;
+        if (model[var] == l_True) {
+            out[i/8] |= 1U << (i%8);
+        }
+    }
+}
+
+DLL_PUBLIC lbool SATSolver::get_samples(
+    uint64_t num_samples
+    , uint8_t* out
+    , const std::vector<uint32_t>* vars
+    , uint64_t* num_samples_done
+    , const vector<Lit>* assumptions
+    , bool only_sampling_solution
+) {
+    if (vars) {
+        for(const uint32_t var: *vars) {
+            if (var >= nVars()) {
+                std::cerr << "ERROR: Variable " << var+1
+                << " requested in get_samples() but there are only "
+                << nVars() << " variables" << endl;
+                exit(-1);
+            }
+        }
+    }
+
+    const size_t bytes = get_sample_bytes(vars ? vars->size() : nVars());
+    uint64_t done = 0;
+    lbool ret = sample(
+        num_samples
+        , [&](const vector<lbool>& model) {
+            pack_sample(model, vars, out + done*bytes);
+            done++;
+            return true;
+        }
+        , assumptions
+        , only_sampling_solution
+    );
+    if (num_samples_done) {
+        *num_samples_done = done;
+    }
+    return ret;
+}
+
 DLL_PUBLIC lbool SATSolver::simplify(const vector< Lit >* assumptions)
 {
     data->num_solve_simplify_calls++;
@@ -520,6 +1175,67 @@ DLL_PUBLIC lbool SATSolver::simplify(const vector< Lit >* assumptions)
     return calc(assumptions, false, data);
 }
 
+DLL_PUBLIC void SATSolver::save_snapshot(
+    const std::string& fname
+    , uint64_t input_size
+    , uint64_t input_hash
+) {
+    if (data->solvers.size() > 1) {
+        if (!actually_add_clauses_to_threads(data)) {
+            data->okay = false;
+        }
+    } else {
+        data->solvers[0]->new_vars(data->vars_to_add);
+        data->vars_to_add = 0;
+    }
+    data->solvers[0]->save_snapshot(fname, input_size, input_hash);
+}
+
+DLL_PUBLIC bool SATSolver::get_snapshot_input(
+    const std::string& fname
+    , uint64_t* input_size
+    , uint64_t* input_hash
+) {
+    return Solver::get_snapshot_input(fname, *input_size, *input_hash);
+}
+
+DLL_PUBLIC bool SATSolver::load_snapshot(
+    const std::string& fname
+    , std::vector<uint32_t>* sampling_vars
+) {
+    if (nVars() > 0 || !data->cls_lits.empty()) {
+        std::cerr << "ERROR: You must call load_snapshot() BEFORE adding variables or clauses" << endl;
+        exit(-1);
+    }
+
+    //Every thread reads its own copy, in parallel
+    vector<char> rets(data->solvers.size());
+    std::vector<std::thread> thds;
+    for(size_t i = 0; i < data->solvers.size(); i++) {
+        thds.push_back(thread([&, i]() {
+            rets[i] = data->solvers[i]->load_snapshot(fname);
+        }));
+    }
+    for(std::thread& thread : thds){
+        thread.join();
+    }
+    //They can only disagree if the file changed while it was read
+    for(size_t i = 1; i < rets.size(); i++) {
+        if (rets[i] != rets[0]) {
+            std::cerr << "ERROR: Snapshot '" << fname << "' changed while it was"
+            << " loaded, thread 0 and thread " << i << " read different problems" << endl;
+            exit(-1);
+        }
+    }
+    data->okay = rets[0];
+
+    const Solver& s = *data->solvers[0];
+    if (sampling_vars && s.conf.sampling_vars) {
+        *sampling_vars = *s.conf.sampling_vars;
+    }
+    return data->okay;
+}
+
 DLL_PUBLIC const vector< lbool >& SATSolver::get_model() const
 {
     return data->solvers[data->which_solved]->get_model();
@@ -657,6 +1373,16 @@ DLL_PUBLIC uint64_t SATSolver::get_sum_conflicts()
     return conlf;
 }
 
+DLL_PUBLIC double SATSolver::get_sum_extend_time()
+{
+    double t = 0;
+    for (size_t i = 0; i < data->solvers.size(); ++i) {
+        Solver& s = *data->solvers[i];
+        t += s.get_extend_time();
+    }
+    return t;
+}
+
 DLL_PUBLIC uint64_t SATSolver::get_sum_propagations()
 {
     uint64_t props = 0;
@@ -722,3 +1448,12 @@ DLL_PUBLIC void SATSolver::set_var_weight(Lit lit, double weight)
         s.set_var_weight(lit, weight);
     }
 }
+
+DLL_PUBLIC void SATSolver::set_var_branch_weight(uint32_t var, double weight)
+{
+    actually_add_clauses_to_threads(data);
+    for (size_t i = 0; i < data->solvers.size(); ++i) {
+        Solver& s = *data->solvers[i];
+        s.set_var_branch_weight(var, weight);
+    }
+}
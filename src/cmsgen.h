@@ -23,10 +23,12 @@ THE SOFTWARE.
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <vector>
 #include <iostream>
 #include <utility>
 #include <string>
+#include <functional>
 #include "solvertypesmini.h"
 
 namespace CMSGen {
@@ -52,8 +54,10 @@ namespace CMSGen {
         void new_vars(const size_t n); //and many new variables to the solver -- much faster
         unsigned nVars() const; //get number of variables inside the solver
         bool add_clause(const std::vector<Lit>& lits);
+        bool add_clauses(const std::vector<Lit>& lits, const std::vector<size_t>& offsets); //clause i is lits[offsets[i]] .. lits[offsets[i+1]-1], so offsets has one more entry than there are clauses -- much faster than add_clause() one by one
         bool add_xor_clause(const std::vector<unsigned>& vars, bool rhs);
         void set_var_weight(Lit lit, double weight);
+        void set_var_branch_weight(uint32_t var, double weight); //relative probability of var being picked for branching, default 1.0
 
         ////////////////////////////
         // Solving and simplifying
@@ -67,6 +71,76 @@ namespace CMSGen {
         bool okay() const; //the problem is still solveable, i.e. the empty clause hasn't been derived
         const std::vector<Lit>& get_decisions_reaching_model() const; //get decisions that lead to model. may NOT work, in case the decisions needed were internal, extended variables. exit(-1)'s in case of such a case. you MUST check decisions_reaching_computed().
 
+        ////////////////////////////
+        // Batch sampling. Assumptions, config checks and startup
+        // simplification are done once per batch, and learnt clauses,
+        // activities and phases carry over between samples, so this is much
+        // cheaper than calling solve() num_samples times. Restart schedule,
+        // VSIDS decay and step size are reset for every sample, as solve()
+        // does, unless set_sample_continue() is on.
+        // With set_num_threads() thread i produces samples i, i+T, i+2T, ...
+        // with its own seed and the callback is called from the calling
+        // thread, in that order. Hence the output is reproducible for a fixed
+        // seed and number of threads. Callback returns false to stop early.
+        // Returns l_True if all samples were generated
+        ////////////////////////////
+        lbool sample(
+            uint64_t num_samples
+            , std::function<bool(const std::vector<lbool>& model)> callback
+            , const std::vector<Lit>* assumptions = 0
+            , bool only_indep_solution = false);
+
+        //Cube-and-sample: splits the space on the cube vars and spreads the
+        //cubes over the threads as assumptions. Each cube gets a number of
+        //samples proportional to its share of some probe samples, so the
+        //workers don't all search the same space. Satisfiable cubes that no
+        //probe hit still get a share. Cube vars are "cube_vars" if given,
+        //else "num_cube_vars" vars (0 = automatic) picked from the sampling
+        //vars, the vars of the recovered XORs or all vars. Given cube vars
+        //must be sampling vars if only_indep_solution is set. At most 10
+        //cube vars are used. Output is reproducible as with sample(), but
+        //the order is not random: samples of one cube come in blocks.
+        lbool sample_cubes(
+            uint64_t num_samples
+            , std::function<bool(const std::vector<lbool>& model)> callback
+            , uint32_t num_cube_vars = 0
+            , const std::vector<uint32_t>* cube_vars = 0
+            , const std::vector<Lit>* assumptions = 0
+            , bool only_indep_solution = false);
+
+        //Same as sample(), but writes samples packed into caller-owned "out",
+        //get_sample_bytes(N) bytes each, where N is vars->size() or nVars().
+        //Bit i of a sample is at out[i/8] & (1<<(i%8)), set iff vars[i]
+        //(or var i) is True. Unset vars (see only_indep_solution) are 0.
+        lbool get_samples(
+            uint64_t num_samples
+            , uint8_t* out
+            , const std::vector<uint32_t>* vars = 0
+            , uint64_t* num_samples_done = 0
+            , const std::vector<Lit>* assumptions = 0
+            , bool only_indep_solution = false);
+        static size_t get_sample_bytes(size_t num_vars);
+        static void pack_sample(
+            const std::vector<lbool>& model
+            , const std::vector<uint32_t>* vars
+            , uint8_t* out);
+
+        //Kept for compatibility, same as sample() with a callback that never stops
+        lbool sample_parallel(
+            uint32_t num_samples
+            , std::function<void(const std::vector<lbool>& model)> callback
+            , const std::vector<Lit>* assumptions = 0
+            , bool only_indep_solution = false);
+
+        ////////////////////////////
+        // Snapshot of the problem after startup simplification. Loading it
+        // into a new SATSolver skips parsing and simplification entirely.
+        // Sampling vars and weights are part of the snapshot.
+        ////////////////////////////
+        void save_snapshot(const std::string& fname, uint64_t input_size = 0, uint64_t input_hash = 0); //simplifies first if not yet done. input_size/input_hash identify the input the problem came from, see get_snapshot_input()
+        static bool get_snapshot_input(const std::string& fname, uint64_t* input_size, uint64_t* input_hash); //reads the input identity saved in the snapshot. Returns false if the file is not a snapshot this version can load
+        bool load_snapshot(const std::string& fname, std::vector<uint32_t>* sampling_vars = 0); //must be called BEFORE adding variables. Returns false if UNSAT. Sampling vars of the snapshot, if any, are put into "sampling_vars"
+
         ////////////////////////////
         // Debug all calls for later replay with --debuglit FILENAME
         ////////////////////////////
@@ -80,6 +154,7 @@ namespace CMSGen {
         // -- be very brittle.
         ////////////////////////////
 
+        void set_num_threads(unsigned n); //sampling threads, must be called before adding variables. Thread i gets seed+i
         void set_allow_otf_gauss(); //allow on-the-fly gaussian elimination
         void set_max_time(double max_time); //max time to run to on next solve() call
         void set_max_confl(int64_t max_confl); //max conflict to run to on next solve() call
@@ -88,6 +163,10 @@ namespace CMSGen {
         void set_no_simplify_at_startup(); //doesn't simplify at start, faster startup time
         void set_no_equivalent_lit_replacement(); //don't replace equivalent literals
         void set_sampling_vars(std::vector<uint32_t>* sampl_vars);
+        void set_sample_continue(bool cont = true); //between samples, backtrack to a random level instead of restarting. Faster, but consecutive samples are correlated, so they are less uniform
+        void set_var_elim(bool elim = true, unsigned threads = 1); //eliminate vars when simplifying, computing resolvents on this many threads. Eliminated vars are not sampled uniformly, sampling vars are never eliminated
+        void set_subsume_threads(unsigned threads); //threads to find subsumed and strengthened long clauses with when simplifying, 1 = serial
+        void set_find_xors(bool find = true, unsigned threads = 1); //recover XORs encoded as clauses when simplifying, on this many threads
         void set_timeout_all_calls(double secs); //max timeout on all subsequent solve() or simplify
         void set_need_decisions_reaching(); //set it before calling solve()
         bool get_decision_reaching_valid() const; //the get_decisions_reaching_model will work -- it may NOT be
@@ -118,6 +197,7 @@ namespace CMSGen {
         uint64_t get_sum_conflicts(); //get total number of conflicts of all time of all threads
         uint64_t get_sum_propagations();  //get total number of propagations of all time made by all threads
         uint64_t get_sum_decisions(); //get total number of decisions of all time made by all threads
+        double get_sum_extend_time(); //get total wall-clock seconds spent extending models to all variables, summed for all threads
 
         void print_stats() const; //print solving stats. Call after solve()/simplify()
         void interrupt_asap(); //call this asynchronously, and the solver will try to cleanly abort asap
@@ -0,0 +1,499 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+//Sampler throughput benchmark. Generates a fixed corpus of instances,
+//samples each and prints the results as JSON. With --baseline, compares
+//samples/sec against an earlier run and fails on regressions.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "cmsgen.h"
+#include "samplefile.h"
+#include "randgen.h"
+#include "argparse.hpp"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+using namespace CMSGen;
+
+struct Instance
+{
+    string name;
+    uint32_t num_vars = 0;
+    vector<vector<Lit> > clauses;
+    vector<std::pair<vector<uint32_t>, bool> > xors;
+    vector<uint32_t> sampling_vars; //if not empty, only these are sampled
+    uint64_t num_samples = 0;
+};
+
+struct Result
+{
+    string name;
+    uint64_t samples = 0;
+    double time = 0;
+    double solve_time = 0;
+    double extend_time = 0;
+    double output_time = 0;
+    uint64_t props = 0;
+    uint64_t peak_rss_kb = 0;
+    bool ok = true;
+};
+
+//The corpus is drawn with RandGen's xoshiro256** and Lemire's bounded draw,
+//not std:: distributions, whose output depends on the standard library.
+//Then results of builds with different standard libraries can be compared
+static Lit rnd_lit(RandGen& rnd, uint32_t num_vars)
+{
+    const uint32_t var = rnd.rnd_uint(num_vars-1);
+    return Lit(var, rnd() & 1);
+}
+
+static Instance random_ksat(uint32_t num_vars, uint32_t num_cls, uint32_t k)
+{
+    RandGen rnd(1);
+    Instance inst;
+    inst.name = "random-" + std::to_string(k) + "sat";
+    inst.num_vars = num_vars;
+    for(uint32_t i = 0; i < num_cls; i++) {
+        vector<Lit> cl;
+        while(cl.size() < k) {
+            const Lit l = rnd_lit(rnd, num_vars);
+            bool dup = false;
+            for(const Lit l2: cl) {
+                dup |= l2.var() == l.var();
+            }
+            if (!dup) {
+                cl.push_back(l);
+            }
+        }
+        inst.clauses.push_back(cl);
+    }
+    return inst;
+}
+
+//Mostly XORs, with a few clauses so it's not pure Gauss-Jordan
+static Instance parity(uint32_t num_vars, uint32_t num_xors, uint32_t num_cls)
+{
+    RandGen rnd(2);
+    Instance inst = random_ksat(num_vars, num_cls, 3);
+    inst.name = "parity";
+    for(uint32_t i = 0; i < num_xors; i++) {
+        vector<uint32_t> vars;
+        const uint32_t size = 3 + rnd.rnd_uint(2);
+        while(vars.size() < size) {
+            const uint32_t v = rnd.rnd_uint(num_vars-1);
+            if (std::find(vars.begin(), vars.end(), v) == vars.end()) {
+                vars.push_back(v);
+            }
+        }
+        inst.xors.push_back(std::make_pair(vars, (bool)(rnd() & 1)));
+    }
+    return inst;
+}
+
+//Mostly binary clauses, as in many industrial instances, so propagation
+//speed is dominated by the binary implications. Binaries are drawn from
+//the literals satisfied by a random assignment, so it's satisfiable.
+static Instance binary_heavy(uint32_t num_vars, uint32_t num_bins, uint32_t num_cls)
+{
+    RandGen rnd(4);
+    Instance inst;
+    inst.name = "binary-heavy";
+    inst.num_vars = num_vars;
+    vector<char> val(num_vars);
+    for(uint32_t i = 0; i < num_vars; i++) {
+        val[i] = rnd() & 1;
+    }
+    auto satisfied = [&](const vector<Lit>& cl) -> bool {
+        for(const Lit l: cl) {
+            if (val[l.var()] ^ l.sign()) {
+                return true;
+            }
+        }
+        return false;
+    };
+    for(uint32_t i = 0; i < num_bins + num_cls; i++) {
+        const uint32_t k = i < num_bins ? 2 : 3;
+        vector<Lit> cl;
+        while(cl.size() < k) {
+            const Lit l = rnd_lit(rnd, num_vars);
+            bool dup = false;
+            for(const Lit l2: cl) {
+                dup |= l2.var() == l.var();
+            }
+            if (!dup) {
+                cl.push_back(l);
+            }
+        }
+        if (!satisfied(cl)) {
+            cl[0] = ~cl[0];
+        }
+        inst.clauses.push_back(cl);
+    }
+    return inst;
+}
+
+//Industrial-style: a random AND-inverter circuit over a few inputs, some
+//constraints on its outputs, sampled projected on the inputs. The
+//constraints hold for a random input, so the instance is satisfiable.
+static Instance projected_circuit(uint32_t num_inputs, uint32_t num_gates)
+{
+    RandGen rnd(3);
+    Instance inst;
+    inst.name = "projected-circuit";
+    inst.num_vars = num_inputs + num_gates;
+    vector<char> val(inst.num_vars);
+    for(uint32_t i = 0; i < num_inputs; i++) {
+        inst.sampling_vars.push_back(i);
+        val[i] = rnd() & 1;
+    }
+    auto lit_val = [&](const Lit l) -> bool {
+        return val[l.var()] ^ l.sign();
+    };
+    for(uint32_t g = 0; g < num_gates; g++) {
+        const uint32_t out = num_inputs + g;
+        //Mostly local fan-in, as in real circuits
+        const uint32_t window = std::min<uint32_t>(out, 1000);
+        const uint32_t in_a = out - window + rnd.rnd_uint(window-1);
+        const Lit a = Lit(in_a, rnd() & 1);
+        const uint32_t in_b = out - window + rnd.rnd_uint(window-1);
+        const Lit b = Lit(in_b, rnd() & 1);
+        inst.clauses.push_back(vector<Lit>{Lit(out, true), a});
+        inst.clauses.push_back(vector<Lit>{Lit(out, true), b});
+        inst.clauses.push_back(vector<Lit>{Lit(out, false), ~a, ~b});
+        val[out] = lit_val(a) && lit_val(b);
+    }
+    for(uint32_t i = 0; i < num_inputs/10; i++) {
+        vector<Lit> cl;
+        for(uint32_t j = 0; j < 3; j++) {
+            const uint32_t gate = num_inputs + rnd.rnd_uint(num_gates-1);
+            cl.push_back(Lit(gate, rnd() & 1));
+        }
+        if (!lit_val(cl[0]) && !lit_val(cl[1]) && !lit_val(cl[2])) {
+            cl[0] = ~cl[0];
+        }
+        inst.clauses.push_back(cl);
+    }
+    return inst;
+}
+
+//Peak RSS since the last call, in KB
+static uint64_t peak_rss_kb()
+{
+    #if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    string line;
+    while(std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::strtoull(line.c_str() + 6, NULL, 10);
+        }
+    }
+    return 0;
+    #elif !defined(_WIN32)
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    #ifdef __APPLE__
+    return ru.ru_maxrss/1024;
+    #else
+    return ru.ru_maxrss;
+    #endif
+    #else
+    return 0;
+    #endif
+}
+
+static void reset_peak_rss()
+{
+    #if defined(__linux__)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    #endif
+}
+
+static double now()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static Result run(
+    const Instance& inst
+    , uint32_t num_threads
+    , uint32_t seed
+    , const string& sample_format
+    , double scale
+    , bool sample_continue
+) {
+    Result res;
+    res.name = inst.name;
+    reset_peak_rss();
+
+    SATSolver solver(NULL, NULL, &seed);
+    solver.set_num_threads(num_threads);
+    solver.set_sample_continue(sample_continue);
+    solver.new_vars(inst.num_vars);
+    for(const auto& cl: inst.clauses) {
+        solver.add_clause(cl);
+    }
+    for(const auto& x: inst.xors) {
+        solver.add_xor_clause(x.first, x.second);
+    }
+    vector<uint32_t> sampling_vars = inst.sampling_vars;
+    const bool only_sampling = !sampling_vars.empty();
+    vector<uint32_t> out_vars;
+    if (only_sampling) {
+        solver.set_sampling_vars(&sampling_vars);
+        out_vars = sampling_vars;
+    } else {
+        for(uint32_t i = 0; i < inst.num_vars; i++) {
+            out_vars.push_back(i);
+        }
+    }
+
+    //Output goes to memory, so disk speed doesn't matter
+    std::ostringstream os;
+    SampleFileWriter writer(&os, out_vars);
+    const uint64_t num_samples = std::max<uint64_t>(1, inst.num_samples*scale);
+    const double start = now();
+    lbool ret = solver.sample(
+        num_samples
+        , [&](const vector<lbool>& model) {
+            const double out_start = now();
+            if (sample_format == "bin") {
+                writer.add(model);
+            } else {
+                for(const uint32_t var: out_vars) {
+                    os << (model[var] == l_True ? "" : "-") << var+1 << ' ';
+                }
+                os << "0\n";
+            }
+            if (os.tellp() > (1 << 20)) {
+                os.str("");
+            }
+            res.samples++;
+            res.output_time += now() - out_start;
+            return true;
+        }
+        , NULL
+        , only_sampling
+    );
+    res.time = now() - start;
+    res.ok = ret == l_True;
+    res.extend_time = solver.get_sum_extend_time();
+    res.solve_time = std::max(0.0, res.time - res.extend_time - res.output_time);
+    res.props = solver.get_sum_propagations();
+    res.peak_rss_kb = peak_rss_kb();
+    return res;
+}
+
+static void print_json(std::ostream& os, const vector<Result>& results, uint32_t num_threads)
+{
+    os << std::fixed;
+    os << "{" << endl;
+    os << "  \"version\": \"" << SATSolver::get_version() << "\"," << endl;
+    os << "  \"sha1\": \"" << SATSolver::get_version_sha1() << "\"," << endl;
+    os << "  \"threads\": " << num_threads << "," << endl;
+    os << "  \"instances\": [" << endl;
+    for(size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        const double per = r.samples ? 1e6/r.samples : 0;
+        os << "    {" << endl
+        << "      \"name\": \"" << r.name << "\"," << endl
+        << "      \"ok\": " << (r.ok ? "true" : "false") << "," << endl
+        << "      \"samples\": " << r.samples << "," << endl
+        << std::setprecision(6)
+        << "      \"time_s\": " << r.time << "," << endl
+        << std::setprecision(2)
+        << "      \"samples_per_sec\": " << r.samples/r.time << "," << endl
+        << "      \"props_per_sec\": " << r.props/r.time << "," << endl
+        << "      \"us_per_sample\": {"
+        << "\"solve\": " << r.solve_time*per
+        << ", \"extend\": " << r.extend_time*per
+        << ", \"output\": " << r.output_time*per
+        << "}," << endl
+        << "      \"peak_rss_kb\": " << r.peak_rss_kb << endl
+        << "    }" << (i+1 < results.size() ? "," : "") << endl;
+    }
+    os << "  ]" << endl;
+    os << "}" << endl;
+}
+
+//Reads "name" -> samples_per_sec from a JSON file written by print_json()
+static std::map<string, double> read_baseline(const string& fname)
+{
+    std::ifstream f(fname);
+    if (!f) {
+        cerr << "ERROR: Cannot open baseline file '" << fname << "'" << endl;
+        exit(-1);
+    }
+    std::stringstream ss;
+    ss << f.rdbuf();
+    const string s = ss.str();
+
+    std::map<string, double> ret;
+    const string name_key = "\"name\": \"";
+    const string sps_key = "\"samples_per_sec\": ";
+    size_t at = 0;
+    while((at = s.find(name_key, at)) != string::npos) {
+        at += name_key.size();
+        const size_t end = s.find('"', at);
+        const size_t sps = s.find(sps_key, end);
+        if (end == string::npos || sps == string::npos) {
+            break;
+        }
+        ret[s.substr(at, end-at)] = std::strtod(s.c_str() + sps + sps_key.size(), NULL);
+        at = sps;
+    }
+    return ret;
+}
+
+int main(int argc, char** argv)
+{
+    argparse::ArgumentParser program("cmsgen-bench");
+    uint32_t num_threads = 1;
+    uint32_t seed = 0;
+    double scale = 1.0;
+    double tolerance = 0.10;
+    string out_fname;
+    string baseline_fname;
+    string sample_format = "text";
+    bool sample_continue = false;
+    program.add_argument("-t", "--threads")
+        .action([&](const auto& a) {num_threads = std::atoi(a.c_str());})
+        .default_value(num_threads)
+        .help("Number of sampling threads");
+    program.add_argument("-s", "--seed")
+        .action([&](const auto& a) {seed = std::atoi(a.c_str());})
+        .default_value(seed)
+        .help("Seed of the sampler. The instances are always the same");
+    program.add_argument("--scale")
+        .action([&](const auto& a) {scale = std::atof(a.c_str());})
+        .default_value(scale)
+        .help("Multiply the number of samples by this");
+    program.add_argument("--sampleformat")
+        .action([&](const auto& a) {sample_format = a;})
+        .default_value(sample_format)
+        .help("Sample output to time: 'text' or 'bin'");
+    program.add_argument("--samplecont")
+        .action([&](const auto&) {sample_continue = true;})
+        .default_value(false)
+        .implicit_value(true)
+        .help("Continue the search between samples instead of restarting");
+    program.add_argument("-o", "--out")
+        .action([&](const auto& a) {out_fname = a;})
+        .help("Write the JSON results here instead of to stdout");
+    program.add_argument("--baseline")
+        .action([&](const auto& a) {baseline_fname = a;})
+        .help("JSON results of an earlier run. Exit with 1 if samples/sec dropped by more than --tolerance on any instance");
+    program.add_argument("--tolerance")
+        .action([&](const auto& a) {tolerance = std::atof(a.c_str());})
+        .default_value(tolerance)
+        .help("Allowed relative drop in samples/sec against the baseline");
+    try {
+        program.parse_args(argc, argv);
+    } catch (const std::exception& err) {
+        cerr << err.what() << endl;
+        cerr << program;
+        exit(-1);
+    }
+    if (num_threads < 1) {
+        cerr << "ERROR: Number of threads must be at least 1" << endl;
+        exit(-1);
+    }
+    if (sample_format != "text" && sample_format != "bin") {
+        cerr << "ERROR: Sample format must be 'text' or 'bin'" << endl;
+        exit(-1);
+    }
+
+    vector<Instance> corpus;
+    corpus.push_back(random_ksat(3000, 7500, 3));
+    corpus.back().num_samples = 2000;
+    corpus.push_back(parity(1000, 300, 1500));
+    corpus.back().num_samples = 1000;
+    corpus.push_back(binary_heavy(20000, 30000, 2000));
+    corpus.back().num_samples = 300;
+    corpus.push_back(projected_circuit(200, 20000));
+    corpus.back().num_samples = 200;
+
+    vector<Result> results;
+    for(const Instance& inst: corpus) {
+        results.push_back(run(inst, num_threads, seed, sample_format, scale, sample_continue));
+        const Result& r = results.back();
+        cerr << "c " << std::left << std::setw(20) << r.name << std::right
+        << " samples/s: " << std::setw(10) << std::fixed << std::setprecision(1)
+        << r.samples/r.time
+        << " T: " << std::setprecision(2) << r.time << " s" << endl;
+    }
+
+    if (out_fname.empty()) {
+        print_json(cout, results, num_threads);
+    } else {
+        std::ofstream f(out_fname);
+        if (!f) {
+            cerr << "ERROR: Cannot open output file '" << out_fname << "'" << endl;
+            exit(-1);
+        }
+        print_json(f, results, num_threads);
+    }
+
+    int ret = 0;
+    for(const Result& r: results) {
+        if (!r.ok) {
+            cerr << "ERROR: Instance " << r.name << " did not produce all samples" << endl;
+            ret = 1;
+        }
+    }
+    if (!baseline_fname.empty()) {
+        const std::map<string, double> base = read_baseline(baseline_fname);
+        for(const Result& r: results) {
+            auto it = base.find(r.name);
+            if (it == base.end()) {
+                continue;
+            }
+            const double sps = r.samples/r.time;
+            if (sps < it->second*(1.0-tolerance)) {
+                cerr << "REGRESSION: " << r.name << " samples/s " << sps
+                << " vs baseline " << it->second << endl;
+                ret = 1;
+            }
+        }
+    }
+
+    return ret;
+}
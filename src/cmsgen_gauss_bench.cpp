@@ -0,0 +1,287 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+//Microbenchmark of the PackedRow kernels. Solves generated XOR instances,
+//takes the matrices MatrixFinder built for Gauss-Jordan elimination, and
+//times row XOR, fused XOR+popcount, set bit scanning and full elimination
+//with every kernel set the CPU supports. Exits with 1 if the kernel sets
+//don't give the same results.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "solver.h"
+#include "gaussian.h"
+#include "packedmatrix.h"
+#include "rowkernels.h"
+#include "argparse.hpp"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+using namespace CMSGen;
+
+struct Timing
+{
+    double xor_ns = 0; ///<Per row operation
+    double xor_popcnt_ns = 0;
+    double scan_ns = 0;
+    double elim_us = 0; ///<Per full elimination
+    uint64_t checksum = 0;
+};
+
+//Same shape as the parity instance of cmsgen-bench
+static void add_parity(Solver& solver, uint32_t num_vars, uint32_t num_xors, uint32_t num_cls)
+{
+    std::mt19937_64 rnd(2);
+    std::uniform_int_distribution<uint32_t> var(0, num_vars-1);
+    std::uniform_int_distribution<uint32_t> sz(3, 5);
+    solver.new_vars(num_vars);
+    for(uint32_t i = 0; i < num_cls; i++) {
+        vector<Lit> cl;
+        for(uint32_t j = 0; j < 3; j++) {
+            cl.push_back(Lit(var(rnd), rnd() & 1));
+        }
+        solver.add_clause_outer(cl);
+    }
+    for(uint32_t i = 0; i < num_xors; i++) {
+        vector<uint32_t> vars;
+        const uint32_t size = sz(rnd);
+        while(vars.size() < size) {
+            const uint32_t v = var(rnd);
+            if (std::find(vars.begin(), vars.end(), v) == vars.end()) {
+                vars.push_back(v);
+            }
+        }
+        solver.add_xor_clause_outer(vars, rnd() & 1);
+    }
+}
+
+static void fill(PackedMatrix& m, const vector<Xor>& xors, uint32_t& num_cols)
+{
+    vector<uint32_t> var_to_col;
+    num_cols = 0;
+    for(const Xor& x: xors) {
+        for(const uint32_t v: x) {
+            if (v >= var_to_col.size()) {
+                var_to_col.resize(v+1, std::numeric_limits<uint32_t>::max());
+            }
+            if (var_to_col[v] == std::numeric_limits<uint32_t>::max()) {
+                var_to_col[v] = num_cols++;
+            }
+        }
+    }
+    m.resize(xors.size(), num_cols);
+    for(uint32_t i = 0; i < xors.size(); i++) {
+        m.getMatrixAt(i).set(xors[i], var_to_col, num_cols);
+    }
+}
+
+static uint64_t hash_matrix(const PackedMatrix& m, uint32_t num_rows, uint32_t num_cols)
+{
+    uint64_t h = 0;
+    for(uint32_t i = 0; i < num_rows; i++) {
+        const PackedRow row = m.getMatrixAt(i);
+        for(uint32_t c = 0; c < num_cols; c++) {
+            h = h*31 + row[c];
+        }
+        h = h*31 + row.rhs();
+    }
+    return h;
+}
+
+//Returns the rank
+static uint32_t eliminate(PackedMatrix& m, uint32_t num_rows, uint32_t num_cols)
+{
+    uint32_t rank = 0;
+    for(uint32_t col = 0; col < num_cols && rank < num_rows; col++) {
+        uint32_t pivot = rank;
+        while(pivot < num_rows && !m.getMatrixAt(pivot)[col]) {
+            pivot++;
+        }
+        if (pivot == num_rows) {
+            continue;
+        }
+        if (pivot != rank) {
+            m.getMatrixAt(rank).swapBoth(m.getMatrixAt(pivot));
+        }
+        const PackedRow pivot_row = m.getMatrixAt(rank);
+        for(uint32_t i = 0; i < num_rows; i++) {
+            PackedRow row = m.getMatrixAt(i);
+            if (i != rank && row[col]) {
+                row.xorBoth(pivot_row);
+            }
+        }
+        rank++;
+    }
+    return rank;
+}
+
+template<class F>
+static double time_ns(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+static Timing run(const PackedMatrix& orig, uint32_t num_rows, uint32_t num_cols, uint32_t reps)
+{
+    Timing t;
+    PackedMatrix m;
+
+    m = orig;
+    t.xor_ns = time_ns([&] {
+        for(uint32_t r = 0; r < reps; r++) {
+            for(uint32_t i = 0; i < num_rows; i++) {
+                m.getMatrixAt(i).xorBoth(m.getMatrixAt((i+1) % num_rows));
+            }
+        }
+    }) / ((double)reps*num_rows);
+    t.checksum = hash_matrix(m, num_rows, num_cols);
+
+    m = orig;
+    uint64_t bits = 0;
+    t.xor_popcnt_ns = time_ns([&] {
+        for(uint32_t r = 0; r < reps; r++) {
+            for(uint32_t i = 0; i < num_rows; i++) {
+                bits += m.getMatrixAt(i).xorBoth_popcnt(m.getMatrixAt((i+1) % num_rows));
+            }
+        }
+    }) / ((double)reps*num_rows);
+    t.checksum = t.checksum*31 + bits;
+
+    uint64_t cols = 0;
+    t.scan_ns = time_ns([&] {
+        for(uint32_t r = 0; r < reps; r++) {
+            for(uint32_t i = 0; i < num_rows; i++) {
+                const PackedRow row = orig.getMatrixAt(i);
+                for(unsigned long c = row.scan(0)
+                    ; c != std::numeric_limits<unsigned long>::max()
+                    ; c = row.scan(c+1)
+                ) {
+                    cols += c;
+                }
+            }
+        }
+    }) / ((double)reps*num_rows);
+    t.checksum = t.checksum*31 + cols;
+
+    const uint32_t elim_reps = std::max<uint32_t>(1, reps/100);
+    uint32_t rank = 0;
+    t.elim_us = time_ns([&] {
+        for(uint32_t r = 0; r < elim_reps; r++) {
+            m = orig;
+            rank = eliminate(m, num_rows, num_cols);
+        }
+    }) / (1000.0*elim_reps);
+    t.checksum = t.checksum*31 + rank;
+    t.checksum = t.checksum*31 + hash_matrix(m, num_rows, num_cols);
+
+    return t;
+}
+
+int main(int argc, char** argv)
+{
+    argparse::ArgumentParser program("cmsgen-gauss-bench");
+    uint32_t reps = 1000;
+    program.add_argument("--reps")
+        .action([&](const auto& a) {reps = std::atoi(a.c_str());})
+        .default_value(reps)
+        .help("Number of times each row operation is repeated over the matrix");
+    try {
+        program.parse_args(argc, argv);
+    } catch (const std::exception& err) {
+        cerr << err.what() << endl;
+        cerr << program;
+        exit(-1);
+    }
+    if (reps == 0) {
+        cerr << "ERROR: --reps must be at least 1" << endl;
+        exit(-1);
+    }
+
+    const vector<std::pair<uint32_t, uint32_t> > sizes = {
+        {1000, 300}, {4000, 1500}, {16000, 6000}};
+    const auto kernels = supported_row_kernels();
+
+    int ret = 0;
+    for(const auto& s: sizes) {
+        SolverConf conf;
+        conf.verbosity = 0;
+        conf.gaussconf.autodisable = false;
+        conf.gaussconf.max_matrix_rows = 2*s.second;
+        std::atomic<bool> must_interrupt(false);
+        Solver solver(&conf, &must_interrupt);
+        add_parity(solver, s.first, s.second, s.first/2);
+        if (solver.solve_with_assumptions(NULL, false) != l_True) {
+            cout << "c parity-" << s.first << " is not satisfiable, skipping" << endl;
+            continue;
+        }
+
+        for(size_t mi = 0; mi < solver.gmatrices.size(); mi++) {
+            const vector<Xor>& xors = solver.gmatrices[mi]->xorclauses;
+            PackedMatrix orig;
+            uint32_t num_cols;
+            fill(orig, xors, num_cols);
+            cout << "c parity-" << s.first << " matrix " << mi
+            << " rows: " << xors.size()
+            << " cols: " << num_cols << endl;
+
+            uint64_t checksum = 0;
+            for(size_t k = 0; k < kernels.size(); k++) {
+                set_row_kernels(kernels[k]);
+                const Timing t = run(orig, xors.size(), num_cols, reps);
+                cout << "c   " << std::left << std::setw(7) << kernels[k]->name
+                << std::right << std::fixed << std::setprecision(1)
+                << " xor: " << std::setw(7) << t.xor_ns << " ns"
+                << " xor+popcnt: " << std::setw(7) << t.xor_popcnt_ns << " ns"
+                << " scan: " << std::setw(7) << t.scan_ns << " ns"
+                << " eliminate: " << std::setw(9) << t.elim_us << " us"
+                << endl;
+                if (k == 0) {
+                    checksum = t.checksum;
+                } else if (t.checksum != checksum) {
+                    cerr << "ERROR: Kernels " << kernels[k]->name
+                    << " and " << kernels[0]->name << " differ" << endl;
+                    ret = 1;
+                }
+            }
+            set_row_kernels(kernels.front());
+        }
+        if (solver.gmatrices.empty()) {
+            cout << "c parity-" << s.first << " had no matrices" << endl;
+        }
+    }
+
+    return ret;
+}
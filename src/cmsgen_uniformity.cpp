@@ -0,0 +1,314 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+//Empirical uniformity check. Generates small CNFs whose solutions can be
+//enumerated, samples each of them many times, both restarting from level 0
+//between samples and with sample continuation (--samplecont), and compares
+//the sample counts against the uniform distribution with a chi-square test.
+//Exits with 1 if continuation is clearly less uniform than restarting.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cmsgen.h"
+#include "argparse.hpp"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+using namespace CMSGen;
+
+struct Instance
+{
+    string name;
+    uint32_t num_vars = 0;
+    vector<vector<Lit> > clauses;
+    vector<std::pair<vector<uint32_t>, bool> > xors;
+};
+
+struct Result
+{
+    uint64_t samples = 0;
+    double chi2 = 0;
+    double p = 0;
+    double tvd = 0; ///<Total variation distance from uniform
+    double repeat = 0; ///<Ratio of samples equal to the one before
+    bool ok = true;
+};
+
+static Instance random_ksat(uint32_t num_vars, uint32_t num_cls, uint32_t k, uint64_t seed)
+{
+    std::mt19937_64 rnd(seed);
+    std::uniform_int_distribution<uint32_t> var(0, num_vars-1);
+    Instance inst;
+    inst.name = "random-" + std::to_string(k) + "sat";
+    inst.num_vars = num_vars;
+    for(uint32_t i = 0; i < num_cls; i++) {
+        vector<Lit> cl;
+        while(cl.size() < k) {
+            const Lit l = Lit(var(rnd), rnd() & 1);
+            bool dup = false;
+            for(const Lit l2: cl) {
+                dup |= l2.var() == l.var();
+            }
+            if (!dup) {
+                cl.push_back(l);
+            }
+        }
+        inst.clauses.push_back(cl);
+    }
+    return inst;
+}
+
+static Instance parity(uint32_t num_vars, uint32_t num_xors, uint32_t num_cls)
+{
+    std::mt19937_64 rnd(2);
+    Instance inst = random_ksat(num_vars, num_cls, 3, 3);
+    inst.name = "parity";
+    std::uniform_int_distribution<uint32_t> var(0, num_vars-1);
+    for(uint32_t i = 0; i < num_xors; i++) {
+        vector<uint32_t> vars;
+        while(vars.size() < 4) {
+            const uint32_t v = var(rnd);
+            if (std::find(vars.begin(), vars.end(), v) == vars.end()) {
+                vars.push_back(v);
+            }
+        }
+        inst.xors.push_back(std::make_pair(vars, (bool)(rnd() & 1)));
+    }
+    return inst;
+}
+
+//Implication chains: the solutions are very unevenly spread over the
+//space, which is where a sampler's bias usually shows
+static Instance chains(uint32_t num_chains, uint32_t chain_len)
+{
+    std::mt19937_64 rnd(4);
+    Instance inst;
+    inst.name = "chains";
+    inst.num_vars = num_chains*chain_len;
+    for(uint32_t c = 0; c < num_chains; c++) {
+        for(uint32_t i = 1; i < chain_len; i++) {
+            const uint32_t v = c*chain_len + i;
+            inst.clauses.push_back(vector<Lit>{Lit(v-1, true), Lit(v, false)});
+        }
+    }
+    std::uniform_int_distribution<uint32_t> var(0, inst.num_vars-1);
+    for(uint32_t i = 0; i < num_chains; i++) {
+        inst.clauses.push_back(vector<Lit>{
+            Lit(var(rnd), rnd() & 1), Lit(var(rnd), rnd() & 1)});
+    }
+    return inst;
+}
+
+static bool satisfied(const Instance& inst, uint64_t assign)
+{
+    for(const auto& cl: inst.clauses) {
+        bool sat = false;
+        for(const Lit l: cl) {
+            sat |= (bool)((assign >> l.var()) & 1) ^ l.sign();
+        }
+        if (!sat) {
+            return false;
+        }
+    }
+    for(const auto& x: inst.xors) {
+        bool val = false;
+        for(const uint32_t v: x.first) {
+            val ^= (assign >> v) & 1;
+        }
+        if (val != x.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Maps every solution to its index
+static std::unordered_map<uint64_t, uint32_t> enumerate(const Instance& inst)
+{
+    std::unordered_map<uint64_t, uint32_t> sols;
+    for(uint64_t assign = 0; assign < (1ULL << inst.num_vars); assign++) {
+        if (satisfied(inst, assign)) {
+            const uint32_t at = sols.size();
+            sols[assign] = at;
+        }
+    }
+    return sols;
+}
+
+//Upper tail of the chi-square distribution, Wilson-Hilferty approximation
+static double chi2_p_value(double chi2, double df)
+{
+    const double a = 2.0/(9.0*df);
+    const double z = (std::cbrt(chi2/df) - (1.0 - a))/std::sqrt(a);
+    return 0.5*std::erfc(z/std::sqrt(2.0));
+}
+
+static Result run(
+    const Instance& inst
+    , const std::unordered_map<uint64_t, uint32_t>& sols
+    , uint64_t num_samples
+    , uint32_t seed
+    , bool sample_continue
+) {
+    Result res;
+    SATSolver solver(NULL, NULL, &seed);
+    solver.set_sample_continue(sample_continue);
+    solver.new_vars(inst.num_vars);
+    for(const auto& cl: inst.clauses) {
+        solver.add_clause(cl);
+    }
+    for(const auto& x: inst.xors) {
+        solver.add_xor_clause(x.first, x.second);
+    }
+
+    vector<uint64_t> count(sols.size(), 0);
+    uint64_t last = std::numeric_limits<uint64_t>::max();
+    uint64_t repeats = 0;
+    solver.sample(
+        num_samples
+        , [&](const vector<lbool>& model) {
+            uint64_t assign = 0;
+            for(uint32_t i = 0; i < inst.num_vars; i++) {
+                if (model[i] == l_True) {
+                    assign |= 1ULL << i;
+                }
+            }
+            auto it = sols.find(assign);
+            if (it == sols.end()) {
+                res.ok = false;
+                return false;
+            }
+            count[it->second]++;
+            repeats += assign == last;
+            last = assign;
+            res.samples++;
+            return true;
+        }
+    );
+    if (!res.ok || res.samples != num_samples) {
+        res.ok = false;
+        return res;
+    }
+
+    const double expected = (double)num_samples/sols.size();
+    for(const uint64_t c: count) {
+        res.chi2 += (c - expected)*(c - expected)/expected;
+        res.tvd += std::abs(c - expected);
+    }
+    res.tvd /= 2.0*num_samples;
+    res.p = sols.size() > 1 ? chi2_p_value(res.chi2, sols.size()-1) : 1.0;
+    res.repeat = (double)repeats/(num_samples-1);
+    return res;
+}
+
+static void print_result(const string& mode, const Result& r, size_t num_sols)
+{
+    cout << "c   " << std::left << std::setw(9) << mode << std::right
+    << std::fixed << std::setprecision(1)
+    << " chi2/df: " << std::setw(6) << r.chi2/std::max<size_t>(1, num_sols-1)
+    << std::setprecision(4)
+    << " p: " << std::setw(6) << r.p
+    << " TVD: " << std::setw(6) << r.tvd
+    << " repeats: " << std::setw(6) << r.repeat
+    << " (uniform: " << 1.0/num_sols << ")" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    argparse::ArgumentParser program("cmsgen-uniformity");
+    uint32_t seed = 0;
+    uint32_t per_solution = 100;
+    double tolerance = 0.5;
+    program.add_argument("-s", "--seed")
+        .action([&](const auto& a) {seed = std::atoi(a.c_str());})
+        .default_value(seed)
+        .help("Seed of the sampler. The instances are always the same");
+    program.add_argument("--persol")
+        .action([&](const auto& a) {per_solution = std::atoi(a.c_str());})
+        .default_value(per_solution)
+        .help("Number of samples to take per solution of the instance");
+    program.add_argument("--tolerance")
+        .action([&](const auto& a) {tolerance = std::atof(a.c_str());})
+        .default_value(tolerance)
+        .help("Allowed relative increase of the chi-square statistic with continuation over restarting");
+    try {
+        program.parse_args(argc, argv);
+    } catch (const std::exception& err) {
+        cerr << err.what() << endl;
+        cerr << program;
+        exit(-1);
+    }
+    if (per_solution < 5) {
+        cerr << "ERROR: Need at least 5 samples per solution for the chi-square test" << endl;
+        exit(-1);
+    }
+
+    vector<Instance> corpus;
+    corpus.push_back(random_ksat(16, 48, 3, 1));
+    corpus.push_back(parity(16, 5, 20));
+    corpus.push_back(chains(4, 4));
+
+    int ret = 0;
+    for(const Instance& inst: corpus) {
+        const auto sols = enumerate(inst);
+        const uint64_t num_samples = per_solution*sols.size();
+        cout << "c " << inst.name << " vars: " << inst.num_vars
+        << " solutions: " << sols.size()
+        << " samples: " << num_samples << endl;
+        if (sols.empty()) {
+            continue;
+        }
+
+        const Result restart = run(inst, sols, num_samples, seed, false);
+        const Result cont = run(inst, sols, num_samples, seed, true);
+        for(const Result* r: {&restart, &cont}) {
+            if (!r->ok) {
+                cerr << "ERROR: Instance " << inst.name
+                << " gave a wrong or missing sample" << endl;
+                ret = 1;
+            }
+        }
+        print_result("restart", restart, sols.size());
+        print_result("continue", cont, sols.size());
+        if (cont.chi2 > restart.chi2*(1.0+tolerance)
+            && cont.p < 0.01
+        ) {
+            cerr << "NONUNIFORM: " << inst.name << " chi2 with continuation "
+            << cont.chi2 << " vs " << restart.chi2 << " restarting" << endl;
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
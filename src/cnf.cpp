@@ -146,12 +146,16 @@ void CNF::swapVars(const uint32_t which, const int off_by)
 {
     std::swap(assigns[nVars()-off_by-1], assigns[which]);
     std::swap(varData[nVars()-off_by-1], varData[which]);
+    std::swap(polar_weight[nVars()-off_by-1], polar_weight[which]);
+    std::swap(polar_threshold[nVars()-off_by-1], polar_threshold[which]);
 }
 
 void CNF::enlarge_nonminimial_datastructs(size_t n)
 {
     assigns.insert(assigns.end(), n, l_Undef);
     varData.insert(varData.end(), n, VarData());
+    polar_weight.insert(polar_weight.end(), n, 0.5);
+    polar_threshold.insert(polar_threshold.end(), n, polar_weight_to_threshold(0.5));
     depth.insert(depth.end(), n, 0);
 }
 
@@ -328,18 +332,16 @@ size_t CNF::mem_used_renumberer() const
 }
 
 
-vector<lbool> CNF::map_back_to_without_bva(const vector<lbool>& val) const
+//outer_to_with_bva_map lists the non-BVA outer vars in increasing order, so
+//this is the same as dropping the BVA vars from val
+void CNF::map_back_to_without_bva(const vector<lbool>& val, vector<lbool>& ret) const
 {
-    vector<lbool> ret;
     assert(val.size() == nVarsOuter());
-    ret.reserve(nVarsOutside());
-    for(size_t i = 0; i < nVarsOuter(); i++) {
-        if (!varData[map_outer_to_inter(i)].is_bva) {
-            ret.push_back(val[i]);
-        }
+    ret.resize(nVarsOutside());
+    for(size_t i = 0; i < nVarsOutside(); i++) {
+        assert(!varData[map_outer_to_inter(outer_to_with_bva_map[i])].is_bva);
+        ret[i] = val[outer_to_with_bva_map[i]];
     }
-    assert(ret.size() == nVarsOutside());
-    return ret;
 }
 
 vector<uint32_t> CNF::build_outer_to_without_bva_map() const
@@ -381,6 +383,7 @@ void CNF::save_state(SimpleOutFile& f) const
 
     f.put_vector(assigns);
     f.put_vector(varData);
+    f.put_vector(polar_weight);
     f.put_uint32_t(minNumVars);
     f.put_uint32_t(num_bva_vars);
     f.put_uint32_t(ok);
@@ -398,6 +401,11 @@ void CNF::load_state(SimpleInFile& f)
 
     f.get_vector(assigns);
     f.get_vector(varData);
+    f.get_vector(polar_weight);
+    polar_threshold.resize(polar_weight.size());
+    for(size_t i = 0; i < polar_weight.size(); i++) {
+        polar_threshold[i] = polar_weight_to_threshold(polar_weight[i]);
+    }
     minNumVars = f.get_uint32_t();
     num_bva_vars = f.get_uint32_t();
     ok = f.get_uint32_t();
@@ -405,6 +413,59 @@ void CNF::load_state(SimpleInFile& f)
     watches.resize(nVars()*2);
 }
 
+//Written in OUTER numbering, so that it can be loaded into a fresh solver
+//where inter == outer, regardless of how the variables have been renumbered
+void CNF::save_snapshot_vars(SimpleOutFile& f) const
+{
+    f.put_uint32_t(num_bva_vars);
+    f.put_vector(outer_to_with_bva_map);
+
+    vector<VarData> outer_data(nVarsOuter());
+    vector<double> outer_weight(nVarsOuter());
+    vector<Lit> units;
+    for(uint32_t outer = 0; outer < nVarsOuter(); outer++) {
+        const uint32_t inter = map_outer_to_inter(outer);
+        VarData& d = outer_data[outer];
+        d.removed = varData[inter].removed;
+        d.polarity = varData[inter].polarity;
+        d.is_bva = varData[inter].is_bva;
+        d.added_for_xor = varData[inter].added_for_xor;
+        outer_weight[outer] = polar_weight[inter];
+        if (assigns[inter] != l_Undef) {
+            units.push_back(Lit(outer, assigns[inter] == l_False));
+        }
+    }
+    f.put_vector(outer_data);
+    f.put_vector(outer_weight);
+    f.put_vector(units);
+}
+
+//Variables must have already been created with new_vars()
+void CNF::load_snapshot_vars(SimpleInFile& f, vector<Lit>& units)
+{
+    num_bva_vars = f.get_uint32_t();
+    outer_to_with_bva_map.clear();
+    f.get_vector(outer_to_with_bva_map);
+
+    vector<VarData> outer_data;
+    f.get_vector(outer_data);
+    assert(outer_data.size() == nVarsOuter());
+    vector<double> outer_weight;
+    f.get_vector(outer_weight);
+    assert(outer_weight.size() == nVarsOuter());
+    for(uint32_t var = 0; var < nVarsOuter(); var++) {
+        assert(map_outer_to_inter(var) == var);
+        polar_weight[var] = outer_weight[var];
+        polar_threshold[var] = polar_weight_to_threshold(outer_weight[var]);
+        varData[var].removed = outer_data[var].removed;
+        varData[var].polarity = outer_data[var].polarity;
+        varData[var].is_bva = outer_data[var].is_bva;
+        varData[var].added_for_xor = outer_data[var].added_for_xor;
+    }
+
+    units.clear();
+    f.get_vector(units);
+}
 
 void CNF::test_all_clause_attached() const
 {
@@ -693,13 +754,13 @@ bool CNF::no_marked_clauses() const
 {
     for(ClOffset offset: longIrredCls) {
         Clause* cl = cl_alloc.ptr(offset);
-        assert(!cl->stats.marked_clause);
+        assert(!cl_alloc.stats(cl).marked_clause);
     }
 
     for(auto& lredcls: longRedCls) {
         for(ClOffset offset: lredcls) {
             Clause* cl = cl_alloc.ptr(offset);
-            assert(!cl->stats.marked_clause);
+            assert(!cl_alloc.stats(cl).marked_clause);
         }
     }
 
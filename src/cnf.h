@@ -23,8 +23,10 @@ THE SOFTWARE.
 #ifndef __CNF_H__
 #define __CNF_H__
 
+#include <algorithm>
 #include <atomic>
 #include <limits>
+#include <cmath>
 #include <random>
 
 #include "constants.h"
@@ -60,6 +62,22 @@ struct LitStats
     uint64_t redLits = 0;
 };
 
+/**
+@brief Polarity weight as a threshold for a 32-bit random word
+
+TRUE is picked iff the word is below the threshold. Scaling by 2^32 and
+flooring is exact in IEEE doubles, so every platform gets the same threshold.
+All-ones means "always", so that a weight of 1.0 stays exact.
+*/
+inline uint32_t polar_weight_to_threshold(const double weight)
+{
+    if (weight >= 1.0) {
+        return std::numeric_limits<uint32_t>::max();
+    }
+    const double t = std::floor(weight * 4294967296.0);
+    return (uint32_t)std::min(t, 4294967294.0);
+}
+
 class CNF
 {
 public:
@@ -76,7 +94,9 @@ public:
         if (_conf != NULL) {
             conf = *_conf;
         }
-        mtrand.seed(conf.origSeed);
+        mtrand.seed(conf.origSeed, conf.rand_gen);
+        cl_alloc.set_huge_pages(conf.huge_pages);
+        watches.set_huge_pages(conf.huge_pages);
         drat = new Drat;
         assert(_must_interrupt_inter != NULL);
         must_interrupt_inter = _must_interrupt_inter;
@@ -90,7 +110,7 @@ public:
 
     ClauseAllocator cl_alloc;
     SolverConf conf;
-    std::mt19937_64 mtrand;
+    RandGen mtrand;
 
     bool ok = true; //If FALSE, state of CNF is UNSAT
 
@@ -100,6 +120,8 @@ public:
     uint32_t gqhead;
     #endif
     vector<VarData> varData;
+    vector<double> polar_weight; ///<Probability of picking TRUE as polarity
+    vector<uint32_t> polar_threshold; ///<polar_weight_to_threshold() of polar_weight
     vector<uint32_t> depth;
     Stamp stamp;
     ImplCache implCache;
@@ -296,18 +318,28 @@ protected:
     virtual void new_var(const bool bva, const uint32_t orig_outer);
     virtual void new_vars(const size_t n);
     void test_reflectivity_of_renumbering() const;
-    vector<lbool> back_number_solution_from_inter_to_outer(const vector<lbool>& solution) const
+    void back_number_solution_from_inter_to_outer(
+        const vector<lbool>& solution
+        , vector<lbool>& back_numbered
+    ) const
     {
-        vector<lbool> back_numbered = solution;
-        updateArrayRev(back_numbered, interToOuterMain);
-        return back_numbered;
+        assert(solution.size() >= interToOuterMain.size());
+        back_numbered.resize(solution.size());
+        for(size_t i = 0; i < interToOuterMain.size(); i++) {
+            back_numbered[interToOuterMain[i]] = solution[i];
+        }
+        for(size_t i = interToOuterMain.size(); i < solution.size(); i++) {
+            back_numbered[i] = solution[i];
+        }
     }
 
-    vector<lbool> map_back_to_without_bva(const vector<lbool>& val) const;
+    void map_back_to_without_bva(const vector<lbool>& val, vector<lbool>& ret) const;
     vector<lbool> assigns;
 
     void save_state(SimpleOutFile& f) const;
     void load_state(SimpleInFile& f);
+    void save_snapshot_vars(SimpleOutFile& f) const;
+    void load_snapshot_vars(SimpleInFile& f, vector<Lit>& units);
     vector<uint32_t> outerToInterMain;
     vector<uint32_t> interToOuterMain;
 
@@ -472,7 +504,7 @@ inline void CNF::unmark_all_irred_clauses()
 {
     for(ClOffset offset: longIrredCls) {
         Clause* cl = cl_alloc.ptr(offset);
-        cl->stats.marked_clause = false;
+        cl_alloc.stats(cl).marked_clause = false;
     }
 }
 
@@ -480,7 +512,7 @@ inline void CNF::unmark_all_red1_clauses()
 {
     for(ClOffset offset: longRedCls[1]) {
         Clause* cl = cl_alloc.ptr(offset);
-        cl->stats.marked_clause = false;
+        cl_alloc.stats(cl).marked_clause = false;
     }
 }
 
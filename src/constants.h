@@ -27,11 +27,10 @@ THE SOFTWARE.
 #include <stdio.h>
 #include <limits>
 #include <random>
+#include "randgen.h"
 
-#define unif_uint_dist(x,y) std::uniform_int_distribution<> x(0, y)
-inline uint32_t rnd_uint(std::mt19937_64& mtrand, const uint32_t maximum) {
-    unif_uint_dist(u, maximum);
-    return u(mtrand);
+inline uint32_t rnd_uint(CMSGen::RandGen& mtrand, const uint32_t maximum) {
+    return mtrand.rnd_uint(maximum);
 }
 
 // #define VERBOSE_DEBUG
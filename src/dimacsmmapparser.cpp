@@ -0,0 +1,620 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "dimacsmmapparser.h"
+#include "streambuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) \
+    && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define DIMACS_SWAR
+#endif
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+static const std::string dimacs_spec = "http://www.satcompetition.org/2009/format-benchmarks2009.html";
+static const std::string please_read_dimacs = "\nPlease read DIMACS specification at http://www.satcompetition.org/2009/format-benchmarks2009.html";
+
+//Each round gives every thread a chunk of about this size
+static const size_t chunk_bytes = 4ULL*1024ULL*1024ULL;
+
+static inline const char* skip_blanks(const char* p, const char* end)
+{
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    return p;
+}
+
+//Start of the next line, or end
+static inline const char* next_line(const char* p, const char* end)
+{
+    const char* nl = (const char*)memchr(p, '\n', end - p);
+    return nl ? nl+1 : end;
+}
+
+/**
+@brief Reads the digits at p into val, returns where they end
+
+Takes 8 bytes at a time and converts them with SWAR arithmetic on one 64-bit
+word, as literals of large CNFs are mostly 4-8 digits long. Numbers that
+don't fit 32 bits are only guaranteed to come out as at least 2^32.
+*/
+static inline const char* parse_digits(const char* p, const char* end, uint64_t& val)
+{
+    static const uint64_t pow10[9] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+    val = 0;
+
+    #ifdef DIMACS_SWAR
+    while (end - p >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+
+        //Digits become 0..9, every other byte gets a bit in its high nibble.
+        //Borrows and carries only spill into the bytes after a non-digit
+        const uint64_t digits = word - 0x3030303030303030ULL;
+        const uint64_t non_digit = (digits | (digits + 0x0606060606060606ULL))
+            & 0xF0F0F0F0F0F0F0F0ULL;
+        const uint32_t n = non_digit ? __builtin_ctzll(non_digit)/8 : 8;
+        if (n == 0) {
+            return p;
+        }
+
+        //Drop what's after the digits, pad with leading zeros, then
+        //combine neighbouring digits, pairs, and quads
+        uint64_t v = digits << (8*(8-n));
+        v = (v * 10) + (v >> 8);
+        v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+            + (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        if (val < (1ULL << 32)) {
+            val = val*pow10[n] + v;
+        }
+        p += n;
+        if (n < 8) {
+            return p;
+        }
+    }
+    #endif
+
+    for(; p != end && *p >= '0' && *p <= '9'; p++) {
+        if (val < (1ULL << 32)) {
+            val = val*10 + (*p - '0');
+        }
+    }
+    return p;
+}
+
+//Reads a number, skipping blanks before it
+static inline bool parse_int(const char*& p, const char* end, int64_t& ret)
+{
+    p = skip_blanks(p, end);
+    bool neg = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        neg = (*p == '-');
+        p++;
+    }
+
+    const char* start = p;
+    uint64_t val;
+    p = parse_digits(p, end, val);
+    if (p == start) {
+        return false;
+    }
+    ret = neg ? -(int64_t)val : (int64_t)val;
+    return true;
+}
+
+static std::string unexpected_char(const char* p, const char* end, const char* expected)
+{
+    std::stringstream ss;
+    if (p == end) {
+        ss << "Unexpected end of file,";
+    } else {
+        ss << "Unexpected char (hex: " << std::hex
+        << std::setw(2) << std::setfill('0')
+        << "0x" << (int)(unsigned char)*p
+        << std::setfill(' ') << std::dec
+        << ")";
+    }
+    ss << " we expected " << expected;
+    return ss.str();
+}
+
+DimacsMmapParser::DimacsMmapParser(
+    SATSolver* _solver
+    , unsigned _verbosity
+    , unsigned _num_threads
+) :
+    solver(_solver)
+    , verbosity(_verbosity)
+    , num_threads(_num_threads)
+{
+    if (num_threads == 0) {
+        num_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+}
+
+DimacsMmapParser::~DimacsMmapParser()
+{
+    #ifndef _WIN32
+    if (data != NULL) {
+        munmap((void*)data, size);
+    }
+    #endif
+}
+
+bool DimacsMmapParser::map_file(const std::string& fname)
+{
+    #ifdef _WIN32
+    return false;
+    #else
+    const int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return false;
+    }
+    size = st.st_size;
+    if (size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void* mem = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        size = 0;
+        return false;
+    }
+    data = (const char*)mem;
+
+    //Gzipped, the streaming parser handles it
+    if (size >= 2
+        && (unsigned char)data[0] == 0x1f
+        && (unsigned char)data[1] == 0x8b
+    ) {
+        munmap(mem, size);
+        data = NULL;
+        size = 0;
+        return false;
+    }
+    madvise(mem, size, MADV_SEQUENTIAL);
+
+    return true;
+    #endif
+}
+
+DimacsMmapParser::Segment& DimacsMmapParser::new_segment(Chunk& c) const
+{
+    if (c.segments.size() <= c.num_segments) {
+        c.segments.resize(c.num_segments+1);
+    }
+    Segment& seg = c.segments[c.num_segments++];
+    seg.lits.clear();
+    seg.offsets.clear();
+    seg.offsets.push_back(0);
+    seg.max_var = 0;
+    seg.first_line = c.num_lines;
+    seg.line = NULL;
+
+    return seg;
+}
+
+//Runs on many threads, only touches "c"
+void DimacsMmapParser::tokenize(Chunk& c) const
+{
+    c.num_lines = 0;
+    c.num_segments = 0;
+    c.error.clear();
+    Segment* seg = &new_segment(c);
+
+    const char* p = c.begin;
+    while (p != c.end) {
+        const char* line = p;
+        p = skip_blanks(p, c.end);
+        if (p == c.end) {
+            break;
+        }
+        if (*p != '-' && *p != '+' && (*p < '0' || *p > '9')) {
+            seg->line = line;
+            p = next_line(p, c.end);
+            c.num_lines++;
+            seg = &new_segment(c);
+            continue;
+        }
+
+        for (;;) {
+            int64_t lit;
+            if (!parse_int(p, c.end, lit)) {
+                c.error = unexpected_char(p, c.end, "a number");
+                return;
+            }
+            if (lit == 0) {
+                break;
+            }
+
+            const uint64_t var = (lit < 0 ? -lit : lit) - 1;
+            if (var >= (1ULL<<28)) {
+                c.error = "Variable requested is far too large: "
+                    + std::to_string(var+1);
+                return;
+            }
+            seg->lits.push_back(Lit(var, lit < 0));
+            seg->max_var = std::max<uint32_t>(seg->max_var, var);
+        }
+        p = skip_blanks(p, c.end);
+        if (p != c.end && *p != '\n') {
+            c.error = unexpected_char(p, c.end
+                , "an end of line character (\\n or \\r + \\n)");
+            return;
+        }
+        seg->offsets.push_back(seg->lits.size());
+        p = next_line(p, c.end);
+        c.num_lines++;
+    }
+}
+
+bool DimacsMmapParser::check_vars(const Segment& seg, const size_t first_line) const
+{
+    if (!header_found) {
+        cerr
+        << "ERROR! "
+        << "DIMACS header ('p cnf vars cls') never found!" << endl;
+        return false;
+    }
+    if ((int64_t)seg.max_var < num_header_vars) {
+        return true;
+    }
+
+    for(size_t i = 0; i+1 < seg.offsets.size(); i++) {
+        for(size_t at = seg.offsets[i]; at < seg.offsets[i+1]; at++) {
+            const uint32_t var = seg.lits[at].var();
+            if ((int64_t)var >= num_header_vars) {
+                cerr
+                << "ERROR! "
+                << "Variable requested is larger than the header told us." << endl
+                << " -> var is : " << var + 1 << endl
+                << " -> header told us maximum will be : " << num_header_vars << endl
+                << " -> At line " << first_line + seg.first_line + i + 1
+                << endl;
+                return false;
+            }
+        }
+    }
+    assert(false);
+    return false;
+}
+
+bool DimacsMmapParser::add_chunk(const Chunk& c, const size_t first_line)
+{
+    for(size_t i = 0; i < c.num_segments; i++) {
+        const Segment& seg = c.segments[i];
+        const size_t num_cls = seg.offsets.size()-1;
+        if (num_cls > 0) {
+            if (!check_vars(seg, first_line)) {
+                return false;
+            }
+            solver->add_clauses(seg.lits, seg.offsets);
+            norm_clauses_added += num_cls;
+        }
+
+        if (seg.line != NULL
+            && !parse_line(seg.line, c.end, first_line + seg.first_line + num_cls)
+        ) {
+            return false;
+        }
+    }
+
+    if (!c.error.empty()) {
+        cerr
+        << "PARSE ERROR! " << c.error << endl
+        << "--> At line " << first_line + c.num_lines + 1
+        << please_read_dimacs
+        << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool DimacsMmapParser::parse_line(const char* p, const char* end, const size_t line_num)
+{
+    p = skip_blanks(p, end);
+    if (p == end || *p == '\n') {
+        cerr
+        << "c WARNING: Empty line at line number " << line_num+1
+        << " -- this is not part of the DIMACS specifications ("
+        << dimacs_spec << "). Ignoring."
+        << endl;
+        return true;
+    }
+
+    switch (*p) {
+        case 'p':
+            return parse_header(p, end, line_num);
+        case 'c':
+            return parse_comment(p+1, end, line_num);
+        case 'w':
+            return parse_weight(p, end, line_num);
+        case 'x':
+            return parse_xor_clause(p+1, end, line_num);
+        default:
+            cerr
+            << "PARSE ERROR! " << unexpected_char(p, end, "a number") << endl
+            << "--> At line " << line_num+1
+            << please_read_dimacs
+            << endl;
+            return false;
+    }
+}
+
+bool DimacsMmapParser::parse_header(const char* p, const char* end, const size_t line_num)
+{
+    if (end - p < 5 || memcmp(p, "p cnf", 5) != 0) {
+        cerr
+        << "PARSE ERROR! " << unexpected_char(p, end, "'p cnf'")
+        << " in the header, at line " << line_num+1
+        << please_read_dimacs
+        << endl;
+        return false;
+    }
+    if (header_found) {
+        cerr << "ERROR: CNF header ('p cnf vars cls') found twice in file! Exiting." << endl;
+        exit(-1);
+    }
+    header_found = true;
+    p += 5;
+
+    int64_t num_cls;
+    if (!parse_int(p, end, num_header_vars)
+        || !parse_int(p, end, num_cls)
+    ) {
+        cerr
+        << "PARSE ERROR! " << unexpected_char(p, end, "a number")
+        << " At line " << line_num+1
+        << endl;
+        return false;
+    }
+    if (verbosity) {
+        cout << "c -- header says num vars:   " << std::setw(12) << num_header_vars << endl;
+        cout << "c -- header says num clauses:" <<  std::setw(12) << num_cls << endl;
+    }
+    if (num_header_vars < 0) {
+        cerr << "ERROR: Number of variables in header cannot be less than 0" << endl;
+        return false;
+    }
+    if (num_cls < 0) {
+        cerr << "ERROR: Number of clauses in header cannot be less than 0" << endl;
+        return false;
+    }
+
+    if (solver->nVars() < (size_t)num_header_vars) {
+        solver->new_vars(num_header_vars-solver->nVars());
+    }
+
+    return true;
+}
+
+bool DimacsMmapParser::parse_comment(const char* p, const char* end, const size_t line_num)
+{
+    p = skip_blanks(p, end);
+    const char* word = p;
+    while (p != end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+        p++;
+    }
+
+    if (p - word == 3 && memcmp(word, "ind", 3) == 0) {
+        for (;;) {
+            int64_t parsed_lit;
+            if (!parse_int(p, end, parsed_lit)) {
+                cerr
+                << "PARSE ERROR! " << unexpected_char(p, end, "a number")
+                << " At line " << line_num+1
+                << endl;
+                return false;
+            }
+            if (parsed_lit == 0) {
+                break;
+            }
+            const uint32_t var = (parsed_lit < 0 ? -parsed_lit : parsed_lit) - 1;
+            sampling_vars.push_back(var);
+        }
+    } else if (verbosity >= 6) {
+        cout
+        << "didn't understand in CNF file comment line:"
+        << "'c " << std::string(word, p) << "'"
+        << endl;
+    }
+
+    return true;
+}
+
+bool DimacsMmapParser::parse_weight(const char* p, const char* end, const size_t line_num)
+{
+    if (end - p < 2 || p[1] != ' ') {
+        cout << "ERROR: weight is not given on line " << line_num << endl;
+        exit(-1);
+    }
+    p += 2;
+
+    int64_t slit;
+    int64_t head;
+    int64_t tail;
+    bool has_tail = false;
+    bool ok = parse_int(p, end, slit) && parse_int(p, end, head);
+    if (ok && p != end && *p == '.') {
+        p++;
+        has_tail = true;
+        ok = parse_int(p, end, tail);
+    }
+    if (!ok) {
+        cout << "ERROR: weight is incorrect on line " << line_num << endl;
+        exit(-1);
+    }
+    if (slit == 0) {
+        cout << "ERROR: Cannot define weight of literal 0!" << endl;
+        exit(-1);
+    }
+
+    const double weight = has_tail ? dimacs_double(head, tail) : head;
+    const uint32_t var = (slit < 0 ? -slit : slit) - 1;
+    solver->set_var_weight(Lit(var, slit < 0), weight);
+    if (weight < 0) {
+        cout << "ERROR: while definint weight, variable " << var+1 << " has is negative weight: " << weight << " -- line " << line_num << endl;
+        exit(-1);
+    }
+
+    return true;
+}
+
+bool DimacsMmapParser::parse_xor_clause(const char* p, const char* end, const size_t line_num)
+{
+    lits.clear();
+    for (;;) {
+        int64_t parsed_lit;
+        if (!parse_int(p, end, parsed_lit)) {
+            cerr
+            << "PARSE ERROR! " << unexpected_char(p, end, "a number") << endl
+            << "--> At line " << line_num+1
+            << please_read_dimacs
+            << endl;
+            return false;
+        }
+        if (parsed_lit == 0) {
+            break;
+        }
+
+        const uint64_t var = (parsed_lit < 0 ? -parsed_lit : parsed_lit) - 1;
+        if (!header_found) {
+            cerr
+            << "ERROR! "
+            << "DIMACS header ('p cnf vars cls') never found!" << endl;
+            return false;
+        }
+        if ((int64_t)var >= num_header_vars) {
+            cerr
+            << "ERROR! "
+            << "Variable requested is larger than the header told us." << endl
+            << " -> var is : " << var + 1 << endl
+            << " -> header told us maximum will be : " << num_header_vars << endl
+            << " -> At line " << line_num+1
+            << endl;
+            return false;
+        }
+        lits.push_back(Lit(var, parsed_lit < 0));
+    }
+    p = skip_blanks(p, end);
+    if (p != end && *p != '\n') {
+        cerr
+        << "PARSE ERROR! "
+        << unexpected_char(p, end, "an end of line character (\\n or \\r + \\n)")
+        << " At line " << line_num+1
+        << endl;
+        return false;
+    }
+    if (lits.empty()) {
+        return true;
+    }
+
+    bool rhs = true;
+    vars.clear();
+    for(const Lit lit: lits) {
+        vars.push_back(lit.var());
+        if (lit.sign()) {
+            rhs ^= true;
+        }
+    }
+    solver->add_xor_clause(vars, rhs);
+    xor_clauses_added++;
+    return true;
+}
+
+bool DimacsMmapParser::parse_DIMACS()
+{
+    const uint32_t origNumVars = solver->nVars();
+    const char* at = data;
+    const char* const end = data + size;
+    size_t line_num = 0;
+
+    chunks.resize(num_threads);
+    while (at != end) {
+        //Cut the next chunks at line ends
+        size_t num_chunks = 0;
+        for(; num_chunks < num_threads && at != end; num_chunks++) {
+            Chunk& c = chunks[num_chunks];
+            c.begin = at;
+            if ((size_t)(end - at) > chunk_bytes) {
+                c.end = next_line(at + chunk_bytes, end);
+            } else {
+                c.end = end;
+            }
+            at = c.end;
+        }
+
+        vector<std::thread> thds;
+        for(size_t i = 1; i < num_chunks; i++) {
+            thds.push_back(std::thread([this, i] {tokenize(chunks[i]);}));
+        }
+        tokenize(chunks[0]);
+        for(std::thread& t: thds) {
+            t.join();
+        }
+
+        //Add them in file order
+        for(size_t i = 0; i < num_chunks; i++) {
+            if (!add_chunk(chunks[i], line_num)) {
+                return false;
+            }
+            line_num += chunks[i].num_lines;
+        }
+    }
+
+    if (verbosity) {
+        cout
+        << "c -- clauses added: " << norm_clauses_added << endl
+        << "c -- xor clauses added: " << xor_clauses_added << endl
+        << "c -- vars added " << (solver->nVars() - origNumVars)
+        << endl;
+    }
+
+    return true;
+}
@@ -0,0 +1,102 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef DIMACSMMAPPARSER_H
+#define DIMACSMMAPPARSER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "cmsgen.h"
+
+using namespace CMSGen;
+using std::vector;
+
+/**
+@brief Parses an uncompressed DIMACS file through mmap, on many threads
+
+The file is cut into chunks at line ends. Each thread tokenizes the clauses
+of its chunk into a flat literal array, then the chunks are added to the
+solver in file order with SATSolver::add_clauses(). The solver therefore ends
+up the same as with DimacsParser. Lines other than clauses ('p cnf', 'c ind',
+'w', 'x' and other comments) are handled in place, in order.
+*/
+class DimacsMmapParser
+{
+    public:
+        DimacsMmapParser(SATSolver* solver, unsigned verbosity, unsigned num_threads);
+        ~DimacsMmapParser();
+
+        ///False if the file can't be mapped, or is gzipped
+        bool map_file(const std::string& fname);
+        bool parse_DIMACS();
+        vector<uint32_t> sampling_vars;
+
+    private:
+        //Consecutive clause lines, then the line that ended them, if any
+        struct Segment
+        {
+            vector<Lit> lits;
+            vector<size_t> offsets; ///<As add_clauses() takes them
+            uint32_t max_var;
+            size_t first_line; ///<Within the chunk
+            const char* line; ///<Not a clause, NULL if the chunk ended
+        };
+
+        struct Chunk
+        {
+            const char* begin;
+            const char* end;
+            size_t num_lines;
+            size_t num_segments;
+            vector<Segment> segments; ///<Kept between chunks to reuse memory
+            std::string error; ///<Parsing stopped here, at line "num_lines"
+        };
+
+        void tokenize(Chunk& c) const;
+        Segment& new_segment(Chunk& c) const;
+        bool add_chunk(const Chunk& c, const size_t first_line);
+        bool check_vars(const Segment& seg, const size_t first_line) const;
+        bool parse_line(const char* p, const char* end, const size_t line_num);
+        bool parse_header(const char* p, const char* end, const size_t line_num);
+        bool parse_comment(const char* p, const char* end, const size_t line_num);
+        bool parse_weight(const char* p, const char* end, const size_t line_num);
+        bool parse_xor_clause(const char* p, const char* end, const size_t line_num);
+
+        SATSolver* solver;
+        unsigned verbosity;
+        unsigned num_threads;
+
+        const char* data = NULL;
+        size_t size = 0;
+
+        bool header_found = false;
+        int64_t num_header_vars = 0;
+        vector<Chunk> chunks;
+        vector<Lit> lits;
+        vector<uint32_t> vars;
+
+        size_t norm_clauses_added = 0;
+        size_t xor_clauses_added = 0;
+};
+
+#endif //DIMACSMMAPPARSER_H
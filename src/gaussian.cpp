@@ -601,7 +601,8 @@ bool EGaussian::find_truths2(
             } else {
                 Clause* cla = solver->cl_alloc.Clause_new(
                     tmp_clause,
-                    solver->sumConflicts
+                    solver->sumConflicts,
+                    ClRegion::gauss_temp
                 );
                 cla->set_gauss_temp_cl();
                 const ClOffset offs = solver->cl_alloc.get_offset(cla);
@@ -819,7 +820,8 @@ void EGaussian::eliminate_col2(uint32_t p, GaussQData& gqd) {
                         } else {
                             Clause* cla = solver->cl_alloc.Clause_new(
                                 tmp_clause,
-                                solver->sumConflicts
+                                solver->sumConflicts,
+                                ClRegion::gauss_temp
                             );
                             cla->set_gauss_temp_cl();
                             const ClOffset offs = solver->cl_alloc.get_offset(cla);
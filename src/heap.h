@@ -104,7 +104,7 @@ public:
         assert(index < (int)heap.size());
         return heap[index];
     }
-    int random_element(std::mt19937_64& rnd)
+    int random_element(RandGen& rnd)
     {
         assert(!heap.empty());
         return heap[rnd_uint(rnd, heap.size()-1)];
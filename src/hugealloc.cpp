@@ -0,0 +1,155 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "hugealloc.h"
+
+#include <stdlib.h>
+#include <cassert>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+using namespace CMSGen;
+
+size_t CMSGen::huge_alloc_size(const size_t bytes, const HugePages mode)
+{
+    if (mode == HugePages::none) {
+        return bytes;
+    }
+    return (bytes + huge_page_bytes - 1) & ~(huge_page_bytes - 1);
+}
+
+#if defined(_WIN32) || !defined(MAP_ANONYMOUS)
+void* CMSGen::huge_alloc(const size_t bytes, const size_t align, const HugePages)
+{
+    #ifdef _WIN32
+    void* mem = _aligned_malloc(bytes, align);
+    #else
+    void* mem = NULL;
+    if (posix_memalign(&mem, align, bytes) != 0) {
+        mem = NULL;
+    }
+    #endif
+    if (mem == NULL) {
+        throw std::bad_alloc();
+    }
+    return mem;
+}
+
+void CMSGen::huge_free(void* mem, const size_t, const HugePages)
+{
+    #ifdef _WIN32
+    _aligned_free(mem);
+    #else
+    free(mem);
+    #endif
+}
+
+void CMSGen::huge_pages_in_use(uint64_t& thp_bytes, uint64_t& explicit_bytes)
+{
+    thp_bytes = 0;
+    explicit_bytes = 0;
+}
+
+#else
+void* CMSGen::huge_alloc(const size_t bytes, const size_t align, const HugePages mode)
+{
+    void* mem = NULL;
+    if (mode == HugePages::none) {
+        if (posix_memalign(&mem, align, bytes) != 0) {
+            throw std::bad_alloc();
+        }
+        return mem;
+    }
+
+    assert(align <= huge_page_bytes);
+    const size_t sz = huge_alloc_size(bytes, mode);
+
+    #ifdef MAP_HUGETLB
+    if (mode == HugePages::explicit_pages) {
+        //Huge pages are aligned to their size
+        mem = mmap(NULL, sz, PROT_READ | PROT_WRITE
+            , MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mem != MAP_FAILED) {
+            return mem;
+        }
+        //The pool is empty or not set up, fall back to transparent ones
+    }
+    #endif
+
+    //Over-allocate, then cut off the unaligned head and the tail
+    char* raw = (char*)mmap(NULL, sz + huge_page_bytes, PROT_READ | PROT_WRITE
+        , MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((void*)raw == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    char* start = (char*)(((uintptr_t)raw + huge_page_bytes - 1) & ~(uintptr_t)(huge_page_bytes - 1));
+    if (start != raw) {
+        munmap(raw, start - raw);
+    }
+    const size_t tail = (raw + sz + huge_page_bytes) - (start + sz);
+    if (tail > 0) {
+        munmap(start + sz, tail);
+    }
+    #ifdef MADV_HUGEPAGE
+    madvise(start, sz, MADV_HUGEPAGE);
+    #endif
+
+    return start;
+}
+
+void CMSGen::huge_free(void* mem, const size_t bytes, const HugePages mode)
+{
+    if (mode == HugePages::none) {
+        free(mem);
+        return;
+    }
+    munmap(mem, huge_alloc_size(bytes, mode));
+}
+
+void CMSGen::huge_pages_in_use(uint64_t& thp_bytes, uint64_t& explicit_bytes)
+{
+    thp_bytes = 0;
+    explicit_bytes = 0;
+
+    std::ifstream f("/proc/self/smaps_rollup");
+    std::string line;
+    while(std::getline(f, line)) {
+        std::istringstream ss(line);
+        std::string key;
+        uint64_t kb = 0;
+        ss >> key >> kb;
+        if (key == "AnonHugePages:") {
+            thp_bytes += kb*1024ULL;
+        } else if (key == "Private_Hugetlb:" || key == "Shared_Hugetlb:") {
+            explicit_bytes += kb*1024ULL;
+        }
+    }
+}
+#endif
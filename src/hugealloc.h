@@ -0,0 +1,78 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef HUGEALLOC_H
+#define HUGEALLOC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace CMSGen {
+
+enum class HugePages {
+    none ///<Ordinary heap memory
+    , transparent ///<mmap, with transparent huge pages requested via madvise()
+    , explicit_pages ///<mmap from the pre-reserved huge page pool, else as transparent
+};
+
+inline std::string getNameOfHugePages(const HugePages h)
+{
+    switch(h) {
+        case HugePages::none:
+            return "off";
+
+        case HugePages::transparent:
+            return "thp";
+
+        case HugePages::explicit_pages:
+            return "explicit";
+    }
+
+    return "unknown";
+}
+
+static const size_t huge_page_bytes = 2ULL << 20;
+
+/**
+@brief Allocates "bytes" of memory, aligned to "align"
+
+With HugePages::none this is an aligned malloc. Otherwise the memory is
+mmap()-ed and rounded up to whole huge pages. It is never pre-faulted, so each
+page is placed on the NUMA node of the thread that first writes it, i.e. the
+solver thread that owns the memory. Throws std::bad_alloc on failure.
+*/
+void* huge_alloc(size_t bytes, size_t align, HugePages mode);
+
+///Frees memory of huge_alloc(), "bytes" and "mode" must be the same as there
+void huge_free(void* mem, size_t bytes, HugePages mode);
+
+///How many bytes huge_alloc() takes for "bytes"
+size_t huge_alloc_size(size_t bytes, HugePages mode);
+
+///Bytes of the process on transparent resp. explicit huge pages, 0 if unknown
+void huge_pages_in_use(uint64_t& thp_bytes, uint64_t& explicit_bytes);
+
+}
+
+#endif //HUGEALLOC_H
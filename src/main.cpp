@@ -49,9 +49,11 @@ THE SOFTWARE.
 #include "main_common.h"
 #include "time_mem.h"
 #include "dimacsparser.h"
+#include "dimacsmmapparser.h"
 #include "cmsgen.h"
 #include "signalcode.h"
 #include "argparse.hpp"
+#include "samplefile.h"
 
 using namespace CMSGen;
 argparse::ArgumentParser program = argparse::ArgumentParser("cmsgen");
@@ -72,6 +74,21 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
     if (conf.verbosity) {
         cout << "c Reading file '" << filename << "'" << endl;
     }
+
+    if (dimacs_parser == "mmap") {
+        DimacsMmapParser parser(solver2, conf.verbosity, parse_threads);
+        if (parser.map_file(filename)) {
+            if (!parser.parse_DIMACS()) {
+                exit(-1);
+            }
+            set_sampling_vars_after_parse(solver2, parser.sampling_vars);
+            return;
+        }
+        if (conf.verbosity) {
+            cout << "c File can't be mapped or is compressed, using the streaming parser" << endl;
+        }
+    }
+
     #ifndef USE_ZLIB
     FILE * in = fopen(filename.c_str(), "rb");
     DimacsParser<StreamBuffer<FILE*, FN> > parser(solver2, &debugLib, conf.verbosity);
@@ -93,8 +110,18 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
     if (!parser.parse_DIMACS(in, strict_header)) {
         exit(-1);
     }
+    set_sampling_vars_after_parse(solver2, parser.sampling_vars);
 
-    if (!sampling_vars_str.empty() && !parser.sampling_vars.empty()) {
+    #ifndef USE_ZLIB
+        fclose(in);
+    #else
+        gzclose(in);
+    #endif
+}
+
+void Main::set_sampling_vars_after_parse(SATSolver* solver2, vector<uint32_t>& parsed_vars)
+{
+    if (!sampling_vars_str.empty() && !parsed_vars.empty()) {
         cerr << "ERROR! Sampling vars set in console but also in CNF." << endl;
         exit(-1);
     }
@@ -113,7 +140,7 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
                 ss.ignore();
         }
     } else {
-        sampling_vars.swap(parser.sampling_vars);
+        sampling_vars.swap(parsed_vars);
     }
 
     if (sampling_vars.empty()) {
@@ -140,12 +167,6 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
         }
     }
     call_after_parse();
-
-    #ifndef USE_ZLIB
-        fclose(in);
-    #else
-        gzclose(in);
-    #endif
 }
 
 void Main::readInStandardInput(SATSolver* solver2)
@@ -206,6 +227,113 @@ void Main::parseInAllFiles(SATSolver* solver2)
     }
 }
 
+//Size and hash of the whole input file, to tell whether a snapshot was made
+//from it. Reads 8 bytes at a time, mixing as clause_hash() does
+static bool hash_input_file(const string& fname, uint64_t& size, uint64_t& hash)
+{
+    FILE* f = fopen(fname.c_str(), "rb");
+    if (f == NULL) {
+        return false;
+    }
+    vector<uint64_t> buf(1ULL << 17);
+    uint64_t x = 0;
+    uint64_t y = 0;
+    size = 0;
+    size_t num;
+    while((num = fread(buf.data(), 1, buf.size()*8, f)) > 0) {
+        if (num % 8 != 0) {
+            memset((char*)buf.data() + num, 0, 8 - num % 8);
+        }
+        for(size_t i = 0; i < (num+7)/8; i++) {
+            x ^= buf[i];
+            y ^= x;
+            x = (x << 12) | (x >> 52);
+            x += y;
+            y = (y << 45) | (y >> 19);
+            y *= 9;
+        }
+        size += num;
+    }
+    const bool read_ok = !ferror(f);
+    fclose(f);
+    hash = (y ^ (x * 0x61C8864680B583EBULL)) * 0x61C8864680B583EBULL;
+    return read_ok;
+}
+
+void Main::load_or_save_snapshot(SATSolver* solver2)
+{
+    //Standard input can't be read twice, so it has no identity
+    uint64_t input_size = 0;
+    uint64_t input_hash = 0;
+    if (fileNamePresent
+        && !hash_input_file(fileToRead, input_size, input_hash)
+    ) {
+        cerr << "ERROR! Could not read input file '" << fileToRead << "'" << endl;
+        exit(-1);
+    }
+
+    struct stat buf;
+    bool load = stat(snapshot_fname.c_str(), &buf) == 0;
+    uint64_t snap_size;
+    uint64_t snap_hash;
+    if (load
+        && fileNamePresent
+        && SATSolver::get_snapshot_input(snapshot_fname, &snap_size, &snap_hash)
+        && (snap_size != input_size || snap_hash != input_hash)
+    ) {
+        cout << "c Snapshot '" << snapshot_fname << "' was made from a different"
+        << " input than '" << fileToRead << "', rebuilding it" << endl;
+        load = false;
+    }
+    if (load && !fileNamePresent) {
+        cout << "c WARNING: input is standard input, it is not read and can't be"
+        << " checked against snapshot '" << snapshot_fname << "'" << endl;
+    }
+
+    if (!load) {
+        parseInAllFiles(solver2);
+        const double myTime = cpuTime();
+        solver2->save_snapshot(snapshot_fname, input_size, input_hash);
+        if (conf.verbosity) {
+            cout << "c Saved snapshot '" << snapshot_fname << "' T: "
+            << std::fixed << std::setprecision(2)
+            << (cpuTime() - myTime) << " s" << endl;
+        }
+        return;
+    }
+
+    if (!sampling_vars_str.empty()) {
+        cerr << "ERROR! Sampling vars set in console but also in the snapshot." << endl;
+        exit(-1);
+    }
+    const double myTime = cpuTime();
+    const bool sat = solver2->load_snapshot(snapshot_fname, &sampling_vars);
+    if (conf.verbosity) {
+        cout << "c Loaded snapshot '" << snapshot_fname << "' T: "
+        << std::fixed << std::setprecision(2)
+        << (cpuTime() - myTime) << " s" << endl;
+    }
+    if (!sat) {
+        //Nothing else is stored, sampling vars included
+        cout << "c Snapshot '" << snapshot_fname << "' holds an UNSAT problem" << endl;
+        return;
+    }
+    if (sampling_vars.empty() && only_sampling_solution) {
+        cout << "ERROR: only sampling vars are requested in the solution, but no sampling vars have been set!" << endl;
+        exit(-1);
+    }
+}
+
+void Main::print_sample(std::ostream* os, const vector<lbool>& model)
+{
+    for (uint32_t var = 0; var < model.size(); var++) {
+        if (model[var] != l_Undef) {
+            *os << ((model[var] == l_True)? "" : "-") << var+1 << " ";
+        }
+    }
+    *os << "0" << endl;
+}
+
 void Main::printResultFunc(
     std::ostream* os
     , const bool toFile
@@ -214,12 +342,7 @@ void Main::printResultFunc(
     assert(toFile);
     assert(ret == l_True || ret == l_False);
     if (ret == l_True) {
-        for (uint32_t var = 0; var < solver->nVars(); var++) {
-            if (solver->get_model()[var] != l_Undef) {
-                *os << ((solver->get_model()[var] == l_True)? "" : "-") << var+1 << " ";
-            }
-        }
-        *os << "0" << endl;
+        print_sample(os, solver->get_model());
     } else if (ret == l_False) {
         cout << "WARNING: No samples generated, CNF is unsatisfiable" << endl;
     }
@@ -237,6 +360,31 @@ void Main::add_supported_options()
         .action([&](const auto& a) {conf.origSeed = std::atoi(a.c_str());})
         .default_value(conf.origSeed)
         .help("Seed");
+    program.add_argument("--randgen")
+        .action([&](const auto& a) {rand_gen = a;})
+        .default_value(rand_gen)
+        .help("Random number generator: 'xoshiro' (fast) or 'mt' (Mersenne Twister, as in earlier versions)");
+    program.add_argument("--polarmode")
+        .action([&](const auto& a) {polar_mode = a;})
+        .default_value(polar_mode)
+        .help("Weighted polarity: 'double' (double compare, as in earlier versions) or 'fixed' (32-bit thresholds, faster, the same on every platform)");
+    program.add_argument("--hugepages")
+        .action([&](const auto& a) {huge_pages = a;})
+        .default_value(huge_pages)
+        .help("Back the clause arena and watch array with huge pages: 'off', 'thp' (transparent) or 'explicit' (from the reserved pool, falling back to transparent)");
+    program.add_argument("-t", "--threads")
+        .action([&](const auto& a) {num_threads = std::atoi(a.c_str());})
+        .default_value(num_threads)
+        .help("Number of threads to sample with. Each thread gets seed+thread_num");
+    program.add_argument("--cube")
+        .action([&](const auto&) {cube_and_sample = true;})
+        .default_value(false)
+        .implicit_value(true)
+        .help("Cube-and-sample: split the space on a few variables and give each thread its own cubes, with sample counts proportional to the cube sizes estimated by probing");
+    program.add_argument("--cubevars")
+        .action([&](const auto& a) {num_cube_vars = std::atoi(a.c_str());})
+        .default_value(num_cube_vars)
+        .help("Number of variables to split on with --cube. 0 = automatic, at most 10");
     program.add_argument("--samples")
         .action([&](const auto& a) {max_nr_of_solutions= std::atoi(a.c_str());})
         .default_value(conf.origSeed)
@@ -245,9 +393,56 @@ void Main::add_supported_options()
         .action([&](const auto& a) {conf.fixed_restart_num_confl = std::atoi(a.c_str());})
         .default_value(conf.fixed_restart_num_confl)
         .help("In case fixed restart strategy is used, how many conflicts should elapse between restarts");
+    program.add_argument("--samplecont")
+        .action([&](const auto&) {conf.sample_continue = true;})
+        .default_value(false)
+        .implicit_value(true)
+        .help("After each sample, backtrack to a random decision level and continue the search from there, instead of restarting from level 0. Trades uniformity for speed: consecutive samples are correlated, so the samples are further from uniform. Off by default, see cmsgen-uniformity for how much");
+    program.add_argument("--varelim")
+        .action([&](const auto&) {conf.doVarElim = true; conf.do_empty_varelim = true;})
+        .default_value(false)
+        .implicit_value(true)
+        .help("Eliminate variables (BVE) when simplifying. Eliminated variables are not sampled uniformly, so use it with sampling variables ('c ind'), which are never eliminated");
+    program.add_argument("--bvethreads")
+        .action([&](const auto& a) {conf.bve_threads = std::atoi(a.c_str());})
+        .default_value(conf.bve_threads)
+        .help("Number of threads to compute variable elimination resolvents with. 1 = serial. The result is the same for any number above 1");
+    program.add_argument("--subthreads")
+        .action([&](const auto& a) {conf.subsume_threads = std::atoi(a.c_str());})
+        .default_value(conf.subsume_threads)
+        .help("Number of threads to find subsumed and strengthened long clauses with during simplification. 1 = serial. The result is the same for any number above 1");
+    program.add_argument("--findxors")
+        .action([&](const auto&) {conf.doFindXors = true;})
+        .default_value(false)
+        .implicit_value(true)
+        .help("Recover XORs encoded as clauses when simplifying, and use them with Gauss-Jordan elimination");
+    program.add_argument("--xorthreads")
+        .action([&](const auto& a) {conf.xor_find_threads = std::atoi(a.c_str());})
+        .default_value(conf.xor_find_threads)
+        .help("Number of threads to recover XORs with. The XORs found are the same for any number");
+    program.add_argument("--parser")
+        .action([&](const auto& a) {dimacs_parser = a;})
+        .default_value(dimacs_parser)
+        .help("CNF file parser: 'stream' or 'mmap' (maps the file and tokenizes it on many threads, for large uncompressed files; compressed ones are streamed)");
+    program.add_argument("--parsethreads")
+        .action([&](const auto& a) {parse_threads = std::atoi(a.c_str());})
+        .default_value(parse_threads)
+        .help("Number of threads of the 'mmap' parser, 0 = one per core");
     program.add_argument("--samplefile")
         .action([&](const auto& a) {resultFilename = a;})
         .help("Write sample(s) to this file");
+    program.add_argument("--snapshot")
+        .action([&](const auto& a) {snapshot_fname = a;})
+        .help("Load the simplified problem from this file if it exists and was made from the same CNF, otherwise parse and simplify the CNF and save it here");
+    program.add_argument("--sampleformat")
+        .action([&](const auto& a) {sample_format = a;})
+        .default_value(sample_format)
+        .help("Sample file format: 'text' (DIMACS-style) or 'bin' (bit-packed, see samplefile.h)");
+    program.add_argument("--onlysampling")
+        .action([&](const auto&) {only_sampling_solution = true;})
+        .default_value(false)
+        .implicit_value(true)
+        .help("Only output the values of the sampling variables");
     program.add_argument("file").remaining().help("input CNF file");
 }
 /* clang-format on */
@@ -272,8 +467,68 @@ void Main::manually_parse_some_options()
         conf.need_decisions_reaching = true;
     }
 
+    if (conf.bve_threads < 1) {
+        cout << "ERROR: Number of BVE threads must be at least 1" << endl;
+        exit(-1);
+    }
+    if (conf.subsume_threads < 1) {
+        cout << "ERROR: Number of subsumption threads must be at least 1" << endl;
+        exit(-1);
+    }
+    if (conf.xor_find_threads < 1) {
+        cout << "ERROR: Number of XOR finding threads must be at least 1" << endl;
+        exit(-1);
+    }
+    if (num_threads < 1) {
+        cout << "ERROR: Number of threads must be at least 1" << endl;
+        exit(-1);
+    }
+
+    if (rand_gen == "xoshiro") {
+        conf.rand_gen = RandGenType::xoshiro;
+    } else if (rand_gen == "mt") {
+        conf.rand_gen = RandGenType::mt;
+    } else {
+        cout << "ERROR: Random number generator must be 'xoshiro' or 'mt'" << endl;
+        exit(-1);
+    }
+
+    if (polar_mode == "fixed") {
+        conf.polarity_mode = PolarityMode::polarmode_weighted_fixed;
+    } else if (polar_mode == "double") {
+        conf.polarity_mode = PolarityMode::polarmode_weighted;
+    } else {
+        cout << "ERROR: Polarity mode must be 'fixed' or 'double'" << endl;
+        exit(-1);
+    }
+
+    if (huge_pages == "off") {
+        conf.huge_pages = HugePages::none;
+    } else if (huge_pages == "thp") {
+        conf.huge_pages = HugePages::transparent;
+    } else if (huge_pages == "explicit") {
+        conf.huge_pages = HugePages::explicit_pages;
+    } else {
+        cout << "ERROR: Huge pages must be 'off', 'thp' or 'explicit'" << endl;
+        exit(-1);
+    }
+
+    if (dimacs_parser != "stream" && dimacs_parser != "mmap") {
+        cout << "ERROR: Parser must be 'stream' or 'mmap'" << endl;
+        exit(-1);
+    }
+
+    if (sample_format != "text" && sample_format != "bin") {
+        cout << "ERROR: Sample format must be 'text' or 'bin'" << endl;
+        exit(-1);
+    }
+
     resultfile = new std::ofstream;
-    resultfile->open(resultFilename.c_str());
+    if (sample_format == "bin") {
+        resultfile->open(resultFilename.c_str(), std::ios::out | std::ios::binary);
+    } else {
+        resultfile->open(resultFilename.c_str());
+    }
     if (!(*resultfile)) {
         cout
         << "ERROR: Couldn't open file '"
@@ -282,7 +537,6 @@ void Main::manually_parse_some_options()
         << endl;
         std::exit(-1);
     }
-    conf.polarity_mode = PolarityMode::polarmode_weighted;
     conf.restartType = Restart::fixed;
 
     vector<std::string> file;
@@ -349,6 +603,7 @@ int Main::solve()
 {
     double myTime = cpuTime();
     solver = new SATSolver((void*)&conf);
+    solver->set_num_threads(num_threads);
     solverToInterrupt = solver;
 
     //Print command line used to execute the solver: for options and inputs
@@ -357,13 +612,18 @@ int Main::solve()
         cout << "c Executed with command line: " << command_line << endl;
     }
 
-    //Parse in DIMACS (maybe gzipped) files
-    parseInAllFiles(solver);
+    //Parse in DIMACS (maybe gzipped) files, or load them pre-simplified
+    if (snapshot_fname.empty()) {
+        parseInAllFiles(solver);
+    } else {
+        load_or_save_snapshot(solver);
+    }
 
-    lbool ret = multi_solutions();
-    //printResultFunc(&cout, false, ret);
     assert(resultfile);
-    printResultFunc(resultfile, true, ret);
+    lbool ret = multi_solutions();
+    if (ret == l_False) {
+        printResultFunc(resultfile, true, ret);
+    }
     if (ret == l_True) {
         cout << "c Finished generating all " << max_nr_of_solutions << " samples" << endl;
     }
@@ -375,29 +635,81 @@ int Main::solve()
 lbool Main::multi_solutions()
 {
     cout << "c Writing samples to file: " << resultFilename << endl;
+    if (!decisions_for_model_fname.empty()) {
+        assert(max_nr_of_solutions == 1);
+    }
+    if (sample_format == "bin") {
+        return multi_solutions_bin();
+    }
+
     unsigned long current_nr_of_solutions = 0;
-    lbool ret = l_True;
-    while(current_nr_of_solutions < max_nr_of_solutions && ret == l_True) {
-        ret = solver->solve(&assumps, only_sampling_solution);
-        current_nr_of_solutions++;
-        if (ret == l_True && !decisions_for_model_fname.empty()) {
-            assert(max_nr_of_solutions == 1);
+    lbool ret = sample(
+        [&](const vector<lbool>& model) {
+            print_sample(resultfile, model);
+            current_nr_of_solutions++;
+            if (current_nr_of_solutions % 10 == 0) {
+                cout
+                << "c Number of samples found until now: "
+                << std::setw(6) << current_nr_of_solutions
+                << endl;
+            }
+            return true;
         }
+    );
+    return ret;
+}
 
-        if (ret == l_True && current_nr_of_solutions < max_nr_of_solutions) {
-            //printResultFunc(&cout, false, ret);
-            if (resultfile) {
-                printResultFunc(resultfile, true, ret);
-            }
+lbool Main::sample(std::function<bool(const vector<lbool>& model)> callback)
+{
+    if (cube_and_sample) {
+        return solver->sample_cubes(
+            max_nr_of_solutions
+            , callback
+            , num_cube_vars
+            , NULL
+            , &assumps
+            , only_sampling_solution
+        );
+    }
+    return solver->sample(
+        max_nr_of_solutions
+        , callback
+        , &assumps
+        , only_sampling_solution
+    );
+}
 
+lbool Main::multi_solutions_bin()
+{
+    vector<uint32_t> vars;
+    uint32_t flags = 0;
+    if (only_sampling_solution) {
+        vars = sampling_vars;
+        flags |= sample_file_only_sampling;
+    } else {
+        vars.resize(solver->nVars());
+        for(uint32_t i = 0; i < vars.size(); i++) {
+            vars[i] = i;
+        }
+    }
+
+    unsigned long current_nr_of_solutions = 0;
+    SampleFileWriter writer(resultfile, vars, flags);
+    lbool ret = sample(
+        [&](const vector<lbool>& model) {
+            writer.add(model);
+            current_nr_of_solutions++;
             if (current_nr_of_solutions % 10 == 0) {
                 cout
                 << "c Number of samples found until now: "
                 << std::setw(6) << current_nr_of_solutions
                 << endl;
             }
+            return true;
         }
-    }
+    );
+    writer.flush();
+    resultfile->flush();
     return ret;
 }
 
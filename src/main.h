@@ -66,8 +66,10 @@ class Main: public MainCommon
 
         //File reading
         void readInAFile(SATSolver* solver2, const string& filename);
+        void set_sampling_vars_after_parse(SATSolver* solver2, vector<uint32_t>& parsed_vars);
         void readInStandardInput(SATSolver* solver2);
         void parseInAllFiles(SATSolver* solver2);
+        void load_or_save_snapshot(SATSolver* solver2);
 
         //Helper functions
         void printResultFunc(
@@ -75,12 +77,24 @@ class Main: public MainCommon
             , const bool toFile
             , const lbool ret
         );
+        void print_sample(std::ostream* os, const vector<lbool>& model);
         void printVersionInfo();
         int correctReturnValue(const lbool ret) const;
         lbool multi_solutions();
+        lbool multi_solutions_bin();
+        lbool sample(std::function<bool(const vector<lbool>& model)> callback);
 
         //Config
         std::string resultFilename = "samples.out";
+        std::string sample_format = "text";
+        std::string dimacs_parser = "stream";
+        unsigned parse_threads = 0;
+        std::string rand_gen = "xoshiro";
+        std::string huge_pages = "off";
+        std::string polar_mode = "double";
+        bool cube_and_sample = false;
+        uint32_t num_cube_vars = 0;
+        std::string snapshot_fname;
         std::string debugLib;
         int printResult = true;
         string command_line;
@@ -84,6 +84,7 @@ OccSimplifier::OccSimplifier(Solver* _solver):
     , seen2(solver->seen2)
     , toClear(solver->toClear)
     , velim_order(VarOrderLt(varElimComplexity))
+    , elim_scratch(seen, toClear)
     //, gateFinder(NULL)
     , anythingHasBeenBlocked(false)
     , blockedMapBuilt(false)
@@ -604,18 +605,19 @@ void OccSimplifier::add_back_to_solver()
         if (complete_clean_clause(*cl)) {
             solver->attachClause(*cl);
             if (cl->red()) {
-                assert(cl->stats.which_red_array < solver->longRedCls.size());
-                if (cl->stats.locked_for_data_gen) {
-                    assert(cl->stats.which_red_array == 0);
-                } else if (cl->stats.glue <= solver->conf.glue_put_lev0_if_below_or_eq) {
-                    cl->stats.which_red_array = 0;
+                ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
+                assert(cl_stats.which_red_array < solver->longRedCls.size());
+                if (cl_stats.locked_for_data_gen) {
+                    assert(cl_stats.which_red_array == 0);
+                } else if (cl_stats.glue <= solver->conf.glue_put_lev0_if_below_or_eq) {
+                    cl_stats.which_red_array = 0;
                 } else if (
-                    cl->stats.glue <= solver->conf.glue_put_lev1_if_below_or_eq
+                    cl_stats.glue <= solver->conf.glue_put_lev1_if_below_or_eq
                     && solver->conf.glue_put_lev1_if_below_or_eq != 0
                 ) {
-                    cl->stats.which_red_array = 1;
+                    cl_stats.which_red_array = 1;
                 }
-                solver->longRedCls[cl->stats.which_red_array].push_back(offs);
+                solver->longRedCls[cl_stats.which_red_array].push_back(offs);
             } else {
                 solver->longIrredCls.push_back(offs);
             }
@@ -823,12 +825,13 @@ bool OccSimplifier::deal_with_added_cl_to_var_lit(const Lit lit)
         if (it->isClause()) {
             ClOffset offs = it->get_offset();
             Clause* cl = solver->cl_alloc.ptr(offs);
+            ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
 
             //Has already been removed or added to "added_long_cl"
-            if (cl->freed() || cl->getRemoved() || cl->stats.marked_clause)
+            if (cl->freed() || cl->getRemoved() || cl_stats.marked_clause)
                 continue;
 
-            cl->stats.marked_clause = 1;
+            cl_stats.marked_clause = 1;
             added_long_cl.push_back(offs);
         }
     }
@@ -922,7 +925,7 @@ bool OccSimplifier::eliminate_vars()
     uint32_t n_cls_last  = sum_irred_cls_longs() + solver->binTri.irredBins;
     uint32_t n_cls_init = n_cls_last;
     uint32_t n_vars_last = solver->get_num_free_vars();
-
+    vector<std::unique_ptr<BveWorker>> workers;
 
     added_bin_cl.clear();
 
@@ -948,6 +951,13 @@ bool OccSimplifier::eliminate_vars()
     }
     last_trail = solver->trail_size();
 
+    if (solver->conf.bve_threads > 1) {
+        for(uint32_t i = 0; i < solver->conf.bve_threads; i++) {
+            workers.push_back(std::unique_ptr<BveWorker>(
+                new BveWorker(solver->nVars()*2)));
+        }
+    }
+
     while(varelim_num_limit > 0
         && varelim_linkin_limit_bytes > 0
         && *limit_to_decrease > 0
@@ -981,6 +991,12 @@ bool OccSimplifier::eliminate_vars()
                 && !solver->must_interrupt_asap()
             ) {
                 assert(limit_to_decrease == &norm_varelim_time_limit);
+                if (!workers.empty()) {
+                    if (!eliminate_var_batch(workers, vars_elimed, last_elimed, wenThrough)) {
+                        goto end;
+                    }
+                    continue;
+                }
                 uint32_t var = velim_order.removeMin();
 
                 //Stats
@@ -1303,7 +1319,7 @@ bool OccSimplifier::execute_simplifier_strategy(const string& strategy)
                 sort_occurs_and_set_abst();
                 for(ClOffset offset: clauses) {
                     Clause* cl = solver->cl_alloc.ptr(offset);
-                    cl->stats.marked_clause = false;
+                    solver->cl_alloc.stats(cl).marked_clause = false;
                 }
             }
         } else if (token == "occ-clean-implicit") {
@@ -2150,12 +2166,13 @@ void OccSimplifier::find_gate(
     Lit elim_lit
     , watch_subarray_const a
     , watch_subarray_const b
+    , ElimScratch& s
 ) {
-    assert(toClear.empty());
+    assert(s.toClear.empty());
     for(const Watched w: a) {
         if (w.isBin() && !w.red()) {
-            seen[(~w.lit2()).toInt()] = 1;
-            toClear.push_back(~w.lit2());
+            s.seen[(~w.lit2()).toInt()] = 1;
+            s.toClear.push_back(~w.lit2());
         }
     }
 
@@ -2176,7 +2193,7 @@ void OccSimplifier::find_gate(
                 bool OK = true;
                 for(const Lit lit: *cl) {
                     if (lit != ~elim_lit) {
-                        if (!seen[lit.toInt()]) {
+                        if (!s.seen[lit.toInt()]) {
                             OK = false;
                             break;
                         }
@@ -2185,36 +2202,37 @@ void OccSimplifier::find_gate(
 
                 //Found all lits inside
                 if (OK) {
-                    cl->stats.marked_clause = true;
-                    gate_varelim_clause = cl;
+                    solver->cl_alloc.stats(cl).marked_clause = true;
+                    s.gate_varelim_clause = cl;
                     break;
                 }
             }
         }
     }
 
-    for(Lit l: toClear) {
-        seen[l.toInt()] = 0;
+    for(Lit l: s.toClear) {
+        s.seen[l.toInt()] = 0;
     }
-    toClear.clear();
+    s.toClear.clear();
 }
 
 void OccSimplifier::mark_gate_in_poss_negs(
     Lit elim_lit
     , watch_subarray_const poss
     , watch_subarray_const negs
+    , ElimScratch& s
 ) {
     //Either of the two is OK. Let's just find ONE, not the biggest one.
     //We could find the biggest one, but it's expensive.
     bool found_pos = false;
-    gate_varelim_clause = NULL;
-    find_gate(elim_lit, poss, negs);
-    if (gate_varelim_clause == NULL) {
-        find_gate(~elim_lit, negs, poss);
+    s.gate_varelim_clause = NULL;
+    find_gate(elim_lit, poss, negs, s);
+    if (s.gate_varelim_clause == NULL) {
+        find_gate(~elim_lit, negs, poss, s);
         found_pos = true;
     }
 
-    if (gate_varelim_clause != NULL && solver->conf.verbosity >= 10) {
+    if (s.gate_varelim_clause != NULL && solver->conf.verbosity >= 10) {
         cout
         << "Lit: " << elim_lit
         << " gate_found_elim_pos:" << found_pos
@@ -2222,7 +2240,7 @@ void OccSimplifier::mark_gate_in_poss_negs(
     }
 }
 
-int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
+int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var, ElimScratch& s)
 {
     assert(solver->ok);
     assert(solver->varData[var].removed == Removed::none);
@@ -2247,7 +2265,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
     const uint32_t neg = n_occurs[Lit(var, true).toInt()];
 
     //Heuristic calculation took too much time
-    if (*limit_to_decrease < 0) {
+    if (*s.limit < 0) {
         return std::numeric_limits<int>::max();
     }
 
@@ -2257,7 +2275,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
     watch_subarray negs = solver->watches[~lit];
     std::sort(poss.begin(), poss.end(), watch_sort_smallest_first());
     std::sort(negs.begin(), negs.end(), watch_sort_smallest_first());
-    resolvents.clear();
+    s.resolvents.clear();
 
     //Pure literal, no resolvents
     //we look at "pos" and "neg" (and not poss&negs) because we don't care about redundant clauses
@@ -2272,9 +2290,9 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
         return std::numeric_limits<int>::max();
     }
 
-    gate_varelim_clause = NULL;
+    s.gate_varelim_clause = NULL;
     if (solver->conf.skip_some_bve_resolvents) {
-        mark_gate_in_poss_negs(lit, poss, negs);
+        mark_gate_in_poss_negs(lit, poss, negs, s);
     }
 
     // Count clauses/literals after elimination
@@ -2286,7 +2304,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
         ; it != end
         ; ++it, at_poss++
     ) {
-        *limit_to_decrease -= 3;
+        *s.limit -= 3;
         if (solver->redundant_or_removed(*it))
             continue;
 
@@ -2295,22 +2313,22 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             ; it2 != end2
             ; it2++, at_negs++
         ) {
-            *limit_to_decrease -= 3;
+            *s.limit -= 3;
             if (solver->redundant_or_removed(*it2))
                 continue;
 
             //Resolve the two clauses
-            bool tautological = resolve_clauses(*it, *it2, lit);
+            bool tautological = resolve_clauses(*it, *it2, lit, s);
             if (tautological) {
                 continue;
             }
 
-            if (solver->satisfied_cl(dummy)) {
+            if (solver->satisfied_cl(s.dummy)) {
                 continue;
             }
 
             #ifdef VERBOSE_DEBUG_VARELIM
-            cout << "Adding new clause due to varelim: " << dummy << endl;
+            cout << "Adding new clause due to varelim: " << s.dummy << endl;
             #endif
 
             after_clauses++;
@@ -2318,13 +2336,13 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             if (after_clauses > (before_clauses + grow)
                 //Too long resolvent
                 || (solver->conf.velim_resolvent_too_large != -1
-                    && ((int)dummy.size() > solver->conf.velim_resolvent_too_large))
+                    && ((int)s.dummy.size() > solver->conf.velim_resolvent_too_large))
                 //Over-time
-                || *limit_to_decrease < -10LL*1000LL
+                || *s.limit < -10LL*1000LL
 
             ) {
-                if (gate_varelim_clause) {
-                    gate_varelim_clause->stats.marked_clause = false;
+                if (s.gate_varelim_clause) {
+                    solver->cl_alloc.stats(s.gate_varelim_clause).marked_clause = false;
                 }
                 return std::numeric_limits<int>::max();
             }
@@ -2335,28 +2353,28 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             #if defined(USE_GAUSS)
             if (it->isBin() && it2->isClause()) {
                 Clause* c = solver->cl_alloc.ptr(it2->get_offset());
-                stats = c->stats;
+                stats = solver->cl_alloc.stats(c);
                 is_xor |= c->used_in_xor();
             } else if (it2->isBin() && it->isClause()) {
                 Clause* c = solver->cl_alloc.ptr(it->get_offset());
-                stats = c->stats;
+                stats = solver->cl_alloc.stats(c);
                 is_xor |= c->used_in_xor();
             } else if (it2->isClause() && it->isClause()) {
                 Clause* c1 = solver->cl_alloc.ptr(it->get_offset());
                 Clause* c2 = solver->cl_alloc.ptr(it2->get_offset());
-                stats = ClauseStats::combineStats(c1->stats, c2->stats);
+                stats = ClauseStats::combineStats(solver->cl_alloc.stats(c1), solver->cl_alloc.stats(c2));
                 is_xor |= c1->used_in_xor();
                 is_xor |= c2->used_in_xor();
             }
             #endif
             //must clear marking that has been set due to gate
             stats.marked_clause = 0;
-            resolvents.add_resolvent(dummy, stats, is_xor);
+            s.resolvents.add_resolvent(s.dummy, stats, is_xor);
         }
     }
 
-    if (gate_varelim_clause) {
-        gate_varelim_clause->stats.marked_clause = false;
+    if (s.gate_varelim_clause) {
+        solver->cl_alloc.stats(s.gate_varelim_clause).marked_clause = false;
     }
 
     return -1;
@@ -2547,15 +2565,23 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
     assert(solver->ok);
     print_var_elim_complexity_stats(var);
     bvestats.testedToElimVars++;
-    const Lit lit = Lit(var, false);
 
     //Heuristic says no, or we ran out of time
-    if (test_elim_and_fill_resolvents(var) > 0
+    elim_scratch.limit = limit_to_decrease;
+    if (test_elim_and_fill_resolvents(var, elim_scratch) > 0
         || *limit_to_decrease < 0
     ) {
         return false;  //didn't eliminate :(
     }
+    eliminate_with_resolvents(var, elim_scratch.resolvents);
+
+    return true; //eliminated!
+}
+
+void OccSimplifier::eliminate_with_resolvents(const uint32_t var, Resolvents& res)
+{
     bvestats.triedToElimVars++;
+    const Lit lit = Lit(var, false);
 
     print_var_eliminate_stat(lit);
 
@@ -2565,41 +2591,201 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
     rem_cls_from_watch_due_to_varelim(solver->watches[~lit], ~lit);
 
     //Add resolvents
-    while(!resolvents.empty()) {
-        if (!add_varelim_resolvent(resolvents.back_lits(),
-            resolvents.back_stats(), resolvents.back_xor())
+    while(!res.empty()) {
+        if (!add_varelim_resolvent(res.back_lits(),
+            res.back_stats(), res.back_xor())
         ) {
             goto end;
         }
-        resolvents.pop();
+        res.pop();
     }
     limit_to_decrease = &norm_varelim_time_limit;
 
 end:
     set_var_as_eliminated(var, lit);
+}
 
-    return true; //eliminated!
+//A var can join the batch if no var of its clauses is in the clauses of a
+//var already in it. Then eliminating one doesn't change the clauses of the
+//others, so their resolvents can be computed at the same time
+bool OccSimplifier::pick_for_bve_batch(const uint32_t var)
+{
+    //Calls f on every var of the clauses of var, stops if it returns false
+    auto all_vars = [&](const std::function<bool(uint32_t)>& f) -> bool {
+        if (!f(var)) {
+            return false;
+        }
+        for(uint32_t sign = 0; sign < 2; sign++) {
+            for(const Watched w: solver->watches[Lit(var, sign)]) {
+                if (w.isBin()) {
+                    if (!f(w.lit2().var())) {
+                        return false;
+                    }
+                } else if (w.isClause()) {
+                    const Clause& cl = *solver->cl_alloc.ptr(w.get_offset());
+                    if (cl.getRemoved()) {
+                        continue;
+                    }
+                    for(const Lit l: cl) {
+                        if (!f(l.var())) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    };
+
+    if (!all_vars([&](uint32_t v) {return !seen2[v];})) {
+        return false;
+    }
+    all_vars([&](uint32_t v) {
+        if (!seen2[v]) {
+            seen2[v] = 1;
+            bve_marked.push_back(v);
+        }
+        return true;
+    });
+    return true;
+}
+
+//Picks a batch of independent vars off velim_order, computes their
+//resolvents on the worker threads, then eliminates them in the order they
+//were picked. Every var is computed with the same starting time limit and
+//its own scratch space, so the result doesn't depend on the number of threads
+bool OccSimplifier::eliminate_var_batch(
+    vector<std::unique_ptr<BveWorker>>& workers
+    , size_t& vars_elimed
+    , int64_t& last_elimed
+    , size_t& wenThrough
+) {
+    const size_t max_batch = 1024;
+    size_t batch_size = 0;
+    uint64_t max_score = 0;
+    bve_deferred.clear();
+    while(!velim_order.empty()
+        && batch_size < max_batch
+        && bve_deferred.size() < max_batch
+        && *limit_to_decrease > 0
+    ) {
+        const uint32_t var = velim_order.removeMin();
+        if (!can_eliminate_var(var)) {
+            *limit_to_decrease -= 20;
+            wenThrough++;
+            continue;
+        }
+        //Serially, eliminating a var often makes its neighbours the
+        //cheapest ones. Taking only the cheap end of the heap keeps that
+        //order, otherwise far more resolvents get added
+        if (batch_size == 0) {
+            max_score = varElimComplexity[var]*2;
+        } else if (varElimComplexity[var] > max_score) {
+            bve_deferred.push_back(var);
+            break;
+        }
+        if (!pick_for_bve_batch(var)) {
+            bve_deferred.push_back(var);
+            continue;
+        }
+        *limit_to_decrease -= 20;
+        wenThrough++;
+
+        if (bve_batch.size() <= batch_size) {
+            bve_batch.resize(batch_size+1);
+        }
+        bve_batch[batch_size++].var = var;
+    }
+    for(const uint32_t v: bve_marked) {
+        seen2[v] = 0;
+    }
+    bve_marked.clear();
+
+    //Compute resolvents. Nothing is changed here but the order of the
+    //watchlists of the vars in the batch and the gate marks of their clauses.
+    const int64_t start_limit = *limit_to_decrease;
+    solver->simp_workers.run_strided(workers.size(), batch_size
+        , [&](const size_t tid, const size_t i) {
+        ElimScratch& s = workers[tid]->scratch;
+        int64_t limit = start_limit;
+        s.limit = &limit;
+        BveCandidate& c = bve_batch[i];
+        c.ret = test_elim_and_fill_resolvents(c.var, s);
+        c.time_used = start_limit - limit;
+        std::swap(c.resolvents, s.resolvents);
+    });
+
+    //Eliminate in order
+    elim_calc_need_update.clear();
+    for(size_t i = 0; i < batch_size; i++) {
+        BveCandidate& c = bve_batch[i];
+        if (varelim_num_limit <= 0
+            || varelim_linkin_limit_bytes <= 0
+            || solver->must_interrupt_asap()
+        ) {
+            bve_deferred.push_back(c.var);
+            continue;
+        }
+
+        print_var_elim_complexity_stats(c.var);
+        bvestats.testedToElimVars++;
+        *limit_to_decrease -= c.time_used;
+        if (c.ret > 0 || *limit_to_decrease < 0) {
+            continue;
+        }
+        eliminate_with_resolvents(c.var, c.resolvents);
+        vars_elimed++;
+        varelim_num_limit--;
+        last_elimed++;
+        if (!solver->ok) {
+            return false;
+        }
+    }
+
+    //SUB and STR for long and short
+    limit_to_decrease = &varelim_sub_str_limit;
+    if (!deal_with_added_long_and_bin(false)) {
+        limit_to_decrease = &norm_varelim_time_limit;
+        return false;
+    }
+    limit_to_decrease = &norm_varelim_time_limit;
+
+    solver->ok = solver->propagate_occur();
+    if (!solver->okay()) {
+        return false;
+    }
+
+    for(const uint32_t var: bve_deferred) {
+        if (can_eliminate_var(var) && !velim_order.inHeap(var)) {
+            varElimComplexity[var] = heuristicCalcVarElimScore(var);
+            velim_order.insert(var);
+        }
+    }
+    update_varelim_complexity_heap();
+
+    return true;
 }
 
 void OccSimplifier::add_pos_lits_to_dummy_and_seen(
     const Watched ps
     , const Lit posLit
+    , ElimScratch& s
 ) {
     if (ps.isBin()) {
-        *limit_to_decrease -= 1;
+        *s.limit -= 1;
         assert(ps.lit2() != posLit);
 
-        seen[ps.lit2().toInt()] = 1;
-        dummy.push_back(ps.lit2());
+        s.seen[ps.lit2().toInt()] = 1;
+        s.dummy.push_back(ps.lit2());
     }
 
     if (ps.isClause()) {
         Clause& cl = *solver->cl_alloc.ptr(ps.get_offset());
-        *limit_to_decrease -= (long)cl.size()/2;
+        *s.limit -= (long)cl.size()/2;
         for (const Lit lit : cl){
             if (lit != posLit) {
-                seen[lit.toInt()] = 1;
-                dummy.push_back(lit);
+                s.seen[lit.toInt()] = 1;
+                s.dummy.push_back(lit);
             }
         }
     }
@@ -2608,34 +2794,35 @@ void OccSimplifier::add_pos_lits_to_dummy_and_seen(
 bool OccSimplifier::add_neg_lits_to_dummy_and_seen(
     const Watched qs
     , const Lit posLit
+    , ElimScratch& s
 ) {
     if (qs.isBin()) {
-        *limit_to_decrease -= 1;
+        *s.limit -= 1;
         assert(qs.lit2() != ~posLit);
 
-        if (seen[(~qs.lit2()).toInt()]) {
+        if (s.seen[(~qs.lit2()).toInt()]) {
             return true;
         }
-        if (!seen[qs.lit2().toInt()]) {
-            dummy.push_back(qs.lit2());
-            seen[qs.lit2().toInt()] = 1;
+        if (!s.seen[qs.lit2().toInt()]) {
+            s.dummy.push_back(qs.lit2());
+            s.seen[qs.lit2().toInt()] = 1;
         }
     }
 
     if (qs.isClause()) {
         Clause& cl = *solver->cl_alloc.ptr(qs.get_offset());
-        *limit_to_decrease -= (long)cl.size()/2;
+        *s.limit -= (long)cl.size()/2;
         for (const Lit lit: cl) {
             if (lit == ~posLit)
                 continue;
 
-            if (seen[(~lit).toInt()]) {
+            if (s.seen[(~lit).toInt()]) {
                 return true;
             }
 
-            if (!seen[lit.toInt()]) {
-                dummy.push_back(lit);
-                seen[lit.toInt()] = 1;
+            if (!s.seen[lit.toInt()]) {
+                s.dummy.push_back(lit);
+                s.seen[lit.toInt()] = 1;
             }
         }
     }
@@ -2647,6 +2834,7 @@ bool OccSimplifier::resolve_clauses(
     const Watched ps
     , const Watched qs
     , const Lit posLit
+    , ElimScratch& s
 ) {
     //If clause has already been freed, skip
     Clause *cl1 = NULL;
@@ -2664,10 +2852,10 @@ bool OccSimplifier::resolve_clauses(
             return true;
         }
     }
-    if (gate_varelim_clause
+    if (s.gate_varelim_clause
         && cl1 && cl2
-        && !cl1->stats.marked_clause
-        && !cl2->stats.marked_clause
+        && !solver->cl_alloc.stats(cl1).marked_clause
+        && !solver->cl_alloc.stats(cl2).marked_clause
     ) {
         //for G (U) R, we only neede to resolve to
         // (Gx * R!x) (U) (G!x * Rx)
@@ -2679,13 +2867,13 @@ bool OccSimplifier::resolve_clauses(
         return true;
     }
 
-    dummy.clear();
-    add_pos_lits_to_dummy_and_seen(ps, posLit);
-    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit);
+    s.dummy.clear();
+    add_pos_lits_to_dummy_and_seen(ps, posLit, s);
+    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit, s);
 
-    *limit_to_decrease -= (long)dummy.size()/2 + 1;
-    for (const Lit lit: dummy) {
-        seen[lit.toInt()] = 0;
+    *s.limit -= (long)s.dummy.size()/2 + 1;
+    for (const Lit lit: s.dummy) {
+        s.seen[lit.toInt()] = 0;
     }
 
     return tautological;
@@ -3018,7 +3206,7 @@ void OccSimplifier::check_elimed_vars_are_unassignedAndStats() const
 size_t OccSimplifier::mem_used() const
 {
     size_t b = 0;
-    b += dummy.capacity()*sizeof(char);
+    b += elim_scratch.dummy.capacity()*sizeof(Lit);
     b += added_long_cl.capacity()*sizeof(ClOffset);
     b += sub_str->mem_used();
     b += blockedClauses.capacity()*sizeof(BlockedClauses);
@@ -3049,7 +3237,7 @@ void OccSimplifier::linkInClause(Clause& cl)
             added_cl_to_var.touch(l.var());
         }
     }
-    assert(cl.stats.marked_clause == 0 && "marks must always be zero at linkin");
+    assert(solver->cl_alloc.stats(cl).marked_clause == 0 && "marks must always be zero at linkin");
 
     std::sort(cl.begin(), cl.end());
     for (const Lit lit: cl) {
@@ -25,6 +25,7 @@ THE SOFTWARE.
 
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <list>
 #include <set>
@@ -301,9 +302,6 @@ private:
     vector<Lit>& toClear;
     vector<bool> sampling_vars_occsimp;
 
-    //Temporaries
-    vector<Lit>     dummy;       ///<Used by merge()
-
     //Time Limits
     uint64_t clause_lits_added;
     int64_t  strengthening_time_limit;              ///<Max. number self-subsuming resolution tries to do this run
@@ -421,9 +419,6 @@ private:
     bool        prop_and_clean_long_and_impl_clauses();
     vector<Lit> tmp_bin_cl;
     void        create_dummy_blocked_clause(const Lit lit);
-    int         test_elim_and_fill_resolvents(uint32_t var);
-    void        mark_gate_in_poss_negs(Lit elim_lit, watch_subarray_const poss, watch_subarray_const negs);
-    void        find_gate(Lit elim_lit, watch_subarray_const a, watch_subarray_const b);
     void        print_var_eliminate_stat(Lit lit) const;
     bool        add_varelim_resolvent(vector<Lit>& finalLits, const ClauseStats& stats, bool is_xor);
     void        update_varelim_complexity_heap();
@@ -481,8 +476,57 @@ private:
             return at;
         }
     };
-    Resolvents resolvents;
-    Clause* gate_varelim_clause;
+
+    //Scratch space for computing the resolvents of one variable.
+    //elim_scratch is the serial one, it uses the solver's seen and toClear.
+    //The worker threads of eliminate_var_batch() each have their own
+    struct ElimScratch {
+        ElimScratch(vector<uint16_t>& _seen, vector<Lit>& _toClear) :
+            seen(_seen)
+            , toClear(_toClear)
+        {}
+
+        vector<uint16_t>& seen;
+        vector<Lit>& toClear;
+        int64_t* limit = NULL; ///<Time limit to decrease
+        vector<Lit> dummy;
+        Resolvents resolvents;
+        Clause* gate_varelim_clause = NULL;
+    };
+    ElimScratch elim_scratch;
+    int         test_elim_and_fill_resolvents(uint32_t var, ElimScratch& s);
+    void        mark_gate_in_poss_negs(Lit elim_lit, watch_subarray_const poss, watch_subarray_const negs, ElimScratch& s);
+    void        find_gate(Lit elim_lit, watch_subarray_const a, watch_subarray_const b, ElimScratch& s);
+    void        eliminate_with_resolvents(const uint32_t var, Resolvents& res);
+
+    //Parallel elimination, see SolverConf::bve_threads
+    struct BveWorker {
+        explicit BveWorker(size_t num_lits) :
+            seen(num_lits, 0)
+            , scratch(seen, toClear)
+        {}
+
+        vector<uint16_t> seen;
+        vector<Lit> toClear;
+        ElimScratch scratch;
+    };
+    struct BveCandidate {
+        uint32_t var;
+        int ret; ///<Of test_elim_and_fill_resolvents()
+        int64_t time_used;
+        Resolvents resolvents;
+    };
+    vector<BveCandidate> bve_batch;
+    vector<uint32_t> bve_deferred; ///<Popped, but clashed with the batch
+    vector<uint32_t> bve_marked;
+    bool        pick_for_bve_batch(const uint32_t var);
+    bool        eliminate_var_batch(
+        vector<std::unique_ptr<BveWorker>>& workers
+        , size_t& vars_elimed
+        , int64_t& last_elimed
+        , size_t& wenThrough
+    );
+
     uint32_t calc_data_for_heuristic(const Lit lit);
     uint64_t time_spent_on_calc_otf_update;
     uint64_t num_otf_update_until_now;
@@ -505,14 +549,17 @@ private:
         const Watched ps
         , const Watched qs
         , const Lit noPosLit
+        , ElimScratch& s
     );
     void add_pos_lits_to_dummy_and_seen(
         const Watched ps
         , const Lit posLit
+        , ElimScratch& s
     );
     bool add_neg_lits_to_dummy_and_seen(
         const Watched qs
         , const Lit posLit
+        , ElimScratch& s
     );
     bool eliminate_vars();
     void eliminate_empty_resolvent_vars();
@@ -32,12 +32,16 @@ THE SOFTWARE.
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include "packedrow.h"
+#include "hugealloc.h"
 
 //#define DEBUG_MATRIX
 
 namespace CMSGen {
 
+//Each row is its rhs, padded to 64 bytes, followed by its bits, padded to a
+//multiple of row_align_words. Rows are 64-byte aligned, see rowkernels.h
 class PackedMatrix
 {
 public:
@@ -50,19 +54,19 @@ public:
 
     ~PackedMatrix()
     {
-        delete[] mp;
+        free_mem();
     }
 
     void resize(const uint32_t num_rows, uint32_t num_cols)
     {
         num_cols = num_cols / 64 + (bool)(num_cols % 64);
-        if (numRows*(numCols+1) < num_rows*(num_cols+1)) {
-            delete[] mp;
-            mp = new uint64_t[num_rows*(num_cols+1)];
-        }
+        alloc(num_rows*row_stride(num_cols));
 
         numRows = num_rows;
         numCols = num_cols;
+        if (mp != NULL) {
+            memset(mp, 0, sizeof(uint64_t)*numRows*row_stride(numCols));
+        }
     }
 
     void resizeNumRows(const uint32_t num_rows)
@@ -80,13 +84,10 @@ public:
         //assert(b.numRows > 0 && b.numCols > 0);
         #endif
 
-        if (numRows*(numCols+1) < b.numRows*(b.numCols+1)) {
-            delete[] mp;
-            mp = new uint64_t[b.numRows*(b.numCols+1)];
-        }
+        alloc(b.numRows*row_stride(b.numCols));
         numRows = b.numRows;
         numCols = b.numCols;
-        memcpy(mp, b.mp, sizeof(uint64_t)*numRows*(numCols+1));
+        memcpy(mp, b.mp, sizeof(uint64_t)*numRows*row_stride(numCols));
 
         return *this;
     }
@@ -97,7 +98,7 @@ public:
         assert(i <= numRows);
         #endif
 
-        return PackedRow(numCols, mp+i*(numCols+1));
+        return PackedRow(numCols, mp+i*row_stride(numCols));
 
     }
 
@@ -107,7 +108,7 @@ public:
         assert(i <= numRows);
         #endif
 
-        return PackedRow(numCols, mp+i*(numCols+1));
+        return PackedRow(numCols, mp+i*row_stride(numCols));
     }
 
     class iterator
@@ -122,25 +123,25 @@ public:
 
         iterator& operator++()
         {
-            mp += (numCols+1);
+            mp += row_stride(numCols);
             return *this;
         }
 
         iterator operator+(const uint32_t num) const
         {
             iterator ret(*this);
-            ret.mp += (numCols+1)*num;
+            ret.mp += row_stride(numCols)*num;
             return ret;
         }
 
         uint32_t operator-(const iterator& b) const
         {
-            return (mp - b.mp)/((numCols+1));
+            return (mp - b.mp)/row_stride(numCols);
         }
 
         void operator+=(const uint32_t num)
         {
-            mp += (numCols+1)*num;  // add by f4
+            mp += row_stride(numCols)*num;  // add by f4
         }
 
         bool operator!=(const iterator& it) const
@@ -170,7 +171,7 @@ public:
 
     inline iterator endMatrix()
     {
-        return iterator(mp+numRows*(numCols+1), numCols);
+        return iterator(mp+numRows*row_stride(numCols), numCols);
     }
 
     inline uint32_t getSize() const
@@ -179,10 +180,36 @@ public:
     }
 
 private:
+    ///Words a row takes, rhs included
+    static uint32_t row_stride(const uint32_t num_cols)
+    {
+        return row_align_words + row_padded_words(num_cols);
+    }
+
+    void alloc(const size_t words)
+    {
+        if (words <= alloc_words) {
+            return;
+        }
+        free_mem();
+        mp = (uint64_t*)huge_alloc(
+            sizeof(uint64_t)*words, sizeof(uint64_t)*row_align_words, HugePages::none);
+        alloc_words = words;
+    }
+
+    void free_mem()
+    {
+        if (mp != NULL) {
+            huge_free(mp, sizeof(uint64_t)*alloc_words, HugePages::none);
+        }
+        mp = NULL;
+        alloc_words = 0;
+    }
 
     uint64_t* mp;
     uint32_t numRows;
     uint32_t numCols;
+    size_t alloc_words = 0;
 };
 
 }
@@ -40,10 +40,10 @@ bool PackedRow::fill(
     bool final = !rhs_internal;
 
     tmp_clause.clear();
-    uint32_t col = 0;
     bool wasundef = false;
-    for (uint32_t i = 0; i < size; i++) for (uint32_t i2 = 0; i2 < 64; i2++) {
-        if ((mp[i] >> i2) &1) {
+    for (uint32_t i = first_nonzero_word(0); i < size; i = first_nonzero_word(i+1)) {
+        for (uint64_t bits = mp[i]; bits; bits &= bits-1) {
+            const uint32_t col = i*64 + my_ctz64(bits);
             const uint32_t& var = col_to_var_original[col];
             assert(var != std::numeric_limits<uint32_t>::max());
 
@@ -59,7 +59,6 @@ bool PackedRow::fill(
                 wasundef = true;
             }
         }
-        col++;
     }
     if (wasundef) {
         tmp_clause[0] ^= final;
@@ -77,38 +76,23 @@ uint32_t PackedRow::find_watchVar(
     vec<bool> &GasVar_state,
     uint32_t& nb_var
 ) {
-    uint32_t  tmp_var = 0;
     uint32_t popcnt = 0;
     nb_var = std::numeric_limits<uint32_t>::max();
-    uint32_t i;
     tmp_clause.clear();
 
-
-    for(i = 0; i < size*64; i++) {
-        if (this->operator[](i)){
-            popcnt++;
-            tmp_var = col_to_var[i];
-            tmp_clause.push_back(Lit(tmp_var, false));
-            if( !GasVar_state[tmp_var] ){  //nobasic
-                nb_var = tmp_var;
-                break;
-            }else{  // basic
-                Lit tmp(tmp_clause[0]);
-                tmp_clause[0] = tmp_clause.back();
-                tmp_clause.back() = tmp;
-            }
-        }
-    }
-
-    for( i = i + 1 ; i <  size*64; i++) {
-        if (this->operator[](i)){
+    //Basic vars are swapped to the front, the first non-basic var is
+    //the one to watch
+    for (uint32_t i = first_nonzero_word(0); i < size; i = first_nonzero_word(i+1)) {
+        for (uint64_t bits = mp[i]; bits; bits &= bits-1) {
+            const uint32_t tmp_var = col_to_var[i*64 + my_ctz64(bits)];
             popcnt++;
-            tmp_var = col_to_var[i];
             tmp_clause.push_back(Lit(tmp_var, false));
-            if( GasVar_state[tmp_var] ){  //basic
+            if (GasVar_state[tmp_var]) {  // basic
                 Lit tmp(tmp_clause[0]);
                 tmp_clause[0] = tmp_clause.back();
                 tmp_clause.back() = tmp;
+            } else if (nb_var == std::numeric_limits<uint32_t>::max()) {
+                nb_var = tmp_var;
             }
         }
     }
@@ -131,49 +115,41 @@ gret PackedRow::propGause(
     nb_var = std::numeric_limits<uint32_t>::max();
     tmp_clause.clear();
 
-    for (uint32_t i = start/64; i != size; i++) if (mp[i]) {
-        uint64_t tmp = mp[i];
-        for (uint32_t i2 = 0 ; i2 < 64; i2++) {
-            if(tmp & 1){
-                const uint32_t var = col_to_var[i * 64  + i2];
-                const lbool val = assigns[var];
-
-                // find non basic value
-                if (val == l_Undef && !GasVar_state[var]) {
-                    nb_var = var;
-                    return gret::nothing_fnewwatch;   // nothing
-                }
-                const bool val_bool = (val == l_True);
-                final ^= val_bool;
-                tmp_clause.push_back(Lit(var, val_bool));
-                if (GasVar_state[var]) {
-                    std::swap(tmp_clause[0], tmp_clause.back());
-                }
+    for (uint32_t i = first_nonzero_word(start/64); i < size; i = first_nonzero_word(i+1)) {
+        for (uint64_t bits = mp[i]; bits; bits &= bits-1) {
+            const uint32_t var = col_to_var[i * 64 + my_ctz64(bits)];
+            const lbool val = assigns[var];
+
+            // find non basic value
+            if (val == l_Undef && !GasVar_state[var]) {
+                nb_var = var;
+                return gret::nothing_fnewwatch;   // nothing
+            }
+            const bool val_bool = (val == l_True);
+            final ^= val_bool;
+            tmp_clause.push_back(Lit(var, val_bool));
+            if (GasVar_state[var]) {
+                std::swap(tmp_clause[0], tmp_clause.back());
             }
-            tmp >>= 1;
         }
     }
 
-    for (uint32_t i =0; i != start/64; i++) if (mp[i]) {
-        uint64_t tmp = mp[i];
-        for (uint32_t i2 = 0 ; i2 < 64; i2++) {
-            if(tmp & 1){
-                const uint32_t var = col_to_var[i * 64  + i2];
-                const lbool val = assigns[var];
-
-                //find non basic value
-                if (val == l_Undef &&  !GasVar_state[var] ){
-                    nb_var = var;
-                    return gret::nothing_fnewwatch;   // nothing
-                }
-                const bool val_bool = (val == l_True);
-                final ^= val_bool;
-                tmp_clause.push_back(Lit(var, val_bool));
-                if (GasVar_state[var]) {
-                    std::swap(tmp_clause[0], tmp_clause.back());
-                }
+    for (uint32_t i = first_nonzero_word(0); i < start/64; i = first_nonzero_word(i+1)) {
+        for (uint64_t bits = mp[i]; bits; bits &= bits-1) {
+            const uint32_t var = col_to_var[i * 64 + my_ctz64(bits)];
+            const lbool val = assigns[var];
+
+            //find non basic value
+            if (val == l_Undef &&  !GasVar_state[var] ){
+                nb_var = var;
+                return gret::nothing_fnewwatch;   // nothing
+            }
+            const bool val_bool = (val == l_True);
+            final ^= val_bool;
+            tmp_clause.push_back(Lit(var, val_bool));
+            if (GasVar_state[var]) {
+                std::swap(tmp_clause[0], tmp_clause.back());
             }
-            tmp >>= 1;
         }
     }
 
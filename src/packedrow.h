@@ -36,6 +36,7 @@ THE SOFTWARE.
 
 #include "solvertypes.h"
 #include "popcnt.h"
+#include "rowkernels.h"
 #include "Vec.h"
 
 namespace CMSGen {
@@ -58,7 +59,8 @@ public:
         assert(size == b.size);
         #endif
 
-        memcpy(mp-1, b.mp-1, size+1);
+        rhs_internal = b.rhs_internal;
+        memcpy(mp, b.mp, sizeof(uint64_t)*size);
         return *this;
     }
 
@@ -70,10 +72,7 @@ public:
         assert(b.size == size);
         #endif
 
-        for (uint32_t i = 0; i != size; i++) {
-            *(mp + i) ^= *(b.mp + i);
-        }
-
+        row_kernels->xor_words(mp, b.mp, row_padded_words(size));
         rhs_internal ^= b.rhs_internal;
         return *this;
     }
@@ -86,24 +85,31 @@ public:
         assert(b.size == size);
         #endif
 
-        for (uint32_t i = 0; i != size; i++) {
-            *(mp + i) ^= *(b.mp + i);
-        }
-
+        row_kernels->xor_words(mp, b.mp, row_padded_words(size));
         rhs_internal ^= b.rhs_internal;
     }
 
+    ///xorBoth(), returning the number of bits set in the result
+    uint32_t xorBoth_popcnt(const PackedRow& b)
+    {
+        #ifdef DEBUG_ROW
+        assert(size > 0);
+        assert(b.size > 0);
+        assert(b.size == size);
+        #endif
+
+        rhs_internal ^= b.rhs_internal;
+        return row_kernels->xor_words_popcnt(mp, b.mp, row_padded_words(size));
+    }
 
     uint32_t popcnt() const;
     bool popcnt_is_one() const
     {
-        int ret = 0;
-        for (uint32_t i = 0; i != size; i++) {
-            ret += my_popcnt(mp[i]&0xffffffff);
-            ret += my_popcnt(mp[i]>>32);
-            if (ret > 1) return false;
+        const uint32_t at = first_nonzero_word(0);
+        if (at == size || my_popcnt64(mp[at]) != 1) {
+            return false;
         }
-        return ret == 1;
+        return first_nonzero_word(at+1) == size;
     }
 
     bool popcnt_is_one(uint32_t from) const
@@ -114,9 +120,17 @@ public:
         tmp >>= from%64;
         if (tmp) return false;
 
-        for (uint32_t i = from/64+1; i != size; i++)
-            if (mp[i]) return false;
-        return true;
+        return first_nonzero_word(from/64+1) == size;
+    }
+
+    ///Index of the first non-zero word at or after "from", size if none
+    inline uint32_t first_nonzero_word(const uint32_t from) const
+    {
+        if (from >= size) {
+            return size;
+        }
+        return std::min(size
+            , row_kernels->first_nonzero_word(mp, from, row_padded_words(size)));
     }
 
     inline const uint64_t& rhs() const
@@ -126,10 +140,7 @@ public:
 
     inline bool isZero() const
     {
-        for (uint32_t i = 0; i != size; i++) {
-            if (mp[i]) return false;
-        }
-        return true;
+        return first_nonzero_word(0) == size;
     }
 
     inline void setZero()
@@ -160,16 +171,8 @@ public:
         assert(b.size == size);
         #endif
 
-        uint64_t * __restrict mp1 = mp-1;
-        uint64_t * __restrict mp2 = b.mp-1;
-
-        uint32_t i = size+1;
-        while(i != 0) {
-            std::swap(*mp1, *mp2);
-            mp1++;
-            mp2++;
-            i--;
-        }
+        std::swap(rhs_internal, b.rhs_internal);
+        std::swap_ranges(mp, mp + size, b.mp);
     }
 
     inline bool operator[](const uint32_t& i) const
@@ -212,19 +215,27 @@ public:
         assert(size > 0);
         #endif
 
-        for(uint32_t i = var; i != size*64; i++) {
-            if (this->operator[](i)) return i;
+        if (var >= size*64) {
+            return std::numeric_limits<unsigned long int>::max();
         }
-
-        return std::numeric_limits<unsigned long int>::max();
+        const uint64_t tmp = mp[var/64] >> (var%64);
+        if (tmp) {
+            return var + my_ctz64(tmp);
+        }
+        const uint32_t at = first_nonzero_word(var/64+1);
+        if (at == size) {
+            return std::numeric_limits<unsigned long int>::max();
+        }
+        return at*64 + my_ctz64(mp[at]);
     }
 
 private:
     friend class PackedMatrix;
     friend std::ostream& operator << (std::ostream& os, const PackedRow& m);
 
+    //The rhs is at _mp, the bits start at the next 64-byte boundary
     PackedRow(const uint32_t _size, uint64_t*  const _mp) :
-        mp(_mp+1)
+        mp(_mp+row_align_words)
         , rhs_internal(*_mp)
         , size(_size)
     {}
@@ -252,7 +263,7 @@ inline bool PackedRow::operator ==(const PackedRow& b) const
     assert(size == b.size);
     #endif
 
-    return (std::equal(b.mp-1, b.mp+size, mp-1));
+    return rhs_internal == b.rhs_internal && std::equal(b.mp, b.mp+size, mp);
 }
 
 inline bool PackedRow::operator !=(const PackedRow& b) const
@@ -263,18 +274,13 @@ inline bool PackedRow::operator !=(const PackedRow& b) const
     assert(size == b.size);
     #endif
 
-    return (!std::equal(b.mp-1, b.mp+size, mp-1));
+    return !(*this == b);
 }
 
 
 inline uint32_t PackedRow::popcnt() const
 {
-    int ret = 0;
-    for (uint32_t i = 0; i != size; i++) {
-        ret += my_popcnt(mp[i]&0xffffffff);
-        ret += my_popcnt(mp[i]>>32);
-    }
-    return ret;
+    return row_kernels->popcnt_words(mp, row_padded_words(size));
 }
 
 }
@@ -30,8 +30,17 @@ THE SOFTWARE.
 
 #if defined (_MSC_VER)
 #define my_popcnt(x) __popcnt64(x)
+#define my_popcnt64(x) __popcnt64(x)
+inline unsigned my_ctz64(unsigned long long x)
+{
+    unsigned long ret;
+    _BitScanForward64(&ret, x);
+    return ret;
+}
 #else
 #define my_popcnt(x) __builtin_popcount(x)
+#define my_popcnt64(x) __builtin_popcountll(x)
+#define my_ctz64(x) __builtin_ctzll(x)
 #endif
 
 #endif //POPCNT__H
@@ -211,18 +211,39 @@ PropBy PropEngine::propagate_any_order_fast()
         Watched* end;
         num_props++;
 
-        for (i = j = ws.begin(), end = ws.end(); unlikely(i != end);) {
-            //Prop bin clause
+        //Binaries are kept at the head of the watchlist, where they never
+        //move, so they are propagated in a tight loop without writes
+        for (i = ws.begin(), end = ws.end(); i != end && i->isBin(); i++) {
+            const lbool val = value(i->lit2());
+            if (val == l_Undef) {
+                enqueue<false>(i->lit2(), PropBy(~p, i->red()));
+            } else if (val == l_False) {
+                confl = PropBy(~p, i->red());
+                failBinLit = i->lit2();
+                qhead = trail.size();
+                break;
+            }
+        }
+        if (!confl.isNULL()) {
+            break;
+        }
+
+        Watched* bin_end = i;
+        for (j = i; unlikely(i != end);) {
+            //Binary behind the long watches (e.g. learnt since): propagate it
+            //and swap it to the end of the binaries at the head
             if (i->isBin()) {
                 assert(j < end);
-                *j++ = *i;
-                const lbool val = value(i->lit2());
+                const Watched w = *i;
+                *j++ = *bin_end;
+                *bin_end++ = w;
+                const lbool val = value(w.lit2());
                 if (val == l_Undef) {
-                    enqueue<false>(i->lit2(), PropBy(~p, i->red()));
+                    enqueue<false>(w.lit2(), PropBy(~p, w.red()));
                     i++;
                 } else if (val == l_False) {
-                    confl = PropBy(~p, i->red());
-                    failBinLit = i->lit2();
+                    confl = PropBy(~p, w.red());
+                    failBinLit = w.lit2();
                     i++;
                     while (i < end) {
                         *j++ = *i++;
@@ -385,6 +406,8 @@ void PropEngine::updateVars(
     , const vector<uint32_t>& interToOuter2
 ) {
     updateArray(varData, interToOuter);
+    updateArray(polar_weight, interToOuter);
+    updateArray(polar_threshold, interToOuter);
     updateArray(assigns, interToOuter);
     assert(decisionLevel() == 0);
 
@@ -71,72 +71,151 @@ enum PropResult {
     , PROP_TODO = 3
 };
 
+/**
+@brief Vars to branch on, picked uniformly at random (or by weight)
+
+Members are kept in "vars", partitioned: the first "boundary" of them are
+assigned, in the order they were assigned, the rest are free to be picked.
+Assigning a member swaps it to the boundary, and as backtracking unassigns
+vars in reverse order, it only needs to move the boundary back to where it
+was when the decision level was opened.
+*/
 struct RandHeap
 {
-    vector<unsigned char> in_heap;
-    vector<uint32_t> vars;
+    vector<uint32_t> vars; //members, the assigned ones first
+    vector<uint32_t> pos; //index of var in "vars", or var_Undef
+    uint32_t boundary = 0; //vars[0..boundary) are assigned
+    vector<uint32_t> lim; //boundary at the start of each decision level
+
+    //Only in weighted mode: Fenwick tree of the weights of the free members,
+    //1-indexed, size is a power of 2 plus 1
+    const vector<double>* weights = NULL;
+    vector<double> tree;
 
     bool inHeap(uint32_t x) const {
-        if (in_heap.size() <= x) {
-            return false;
-        }
-        return in_heap[x];
+        return x < pos.size() && pos[x] != var_Undef;
     }
 
     void clear() {
-        in_heap.clear();
+        pos.clear();
         vars.clear();
+        tree.clear();
+        boundary = 0;
+        std::fill(lim.begin(), lim.end(), 0);
     }
 
     void insert(uint32_t x) {
         assert(!inHeap(x));
-        if (in_heap.size() <= x) {
-            uint32_t n = x - in_heap.size() + 1;
-            in_heap.insert(in_heap.end(), n, false);
+        if (pos.size() <= x) {
+            pos.resize(x+1, var_Undef);
         }
-        in_heap[x] = true;
+        pos[x] = vars.size();
         vars.push_back(x);
+        if (weights) {
+            tree_add(x, (*weights)[x]);
+        }
+    }
+
+    void remove(uint32_t x) {
+        if (!inHeap(x)) {
+            return;
+        }
+        uint32_t at = pos[x];
+        if (at < boundary) {
+            //Keep the assigned ones in order: the hole moves up through the
+            //decision levels, taking the last var of each
+            uint32_t level = std::upper_bound(lim.begin(), lim.end(), at) - lim.begin();
+            for(; level < lim.size(); level++) {
+                move(lim[level]-1, at);
+                at = lim[level]-1;
+                lim[level]--;
+            }
+            move(boundary-1, at);
+            at = boundary-1;
+            boundary--;
+        } else if (weights) {
+            tree_add(x, -(*weights)[x]);
+        }
+        move(vars.size()-1, at);
+        vars.pop_back();
+        pos[x] = var_Undef;
     }
 
+    //Var was assigned
+    void assigned(uint32_t x) {
+        if (!inHeap(x) || pos[x] < boundary) {
+            return;
+        }
+        const uint32_t at = pos[x];
+        const uint32_t other = vars[boundary];
+        vars[at] = other;
+        pos[other] = at;
+        vars[boundary] = x;
+        pos[x] = boundary;
+        boundary++;
+        if (weights) {
+            tree_add(x, -(*weights)[x]);
+        }
+    }
+
+    void new_level() {
+        lim.push_back(boundary);
+    }
+
+    //All vars assigned above "level" become free again
+    void backtrack(uint32_t level) {
+        const uint32_t new_boundary = lim[level];
+        if (weights) {
+            for(uint32_t i = new_boundary; i < boundary; i++) {
+                tree_add(vars[i], (*weights)[vars[i]]);
+            }
+        }
+        boundary = new_boundary;
+        lim.resize(level);
+    }
+
+    //Number of free members
     size_t size() const {
-        return vars.size();
+        return vars.size() - boundary;
     }
 
     void print_heap() const {
-        for(const auto& x: vars) {
-            cout << x << ", ";
+        for(uint32_t i = boundary; i < vars.size(); i++) {
+            cout << vars[i] << ", ";
         }
         cout << endl;
     }
 
     uint32_t mem_used() const {
         uint32_t ret = 0;
-        ret += in_heap.capacity() * sizeof(unsigned char);
+        ret += pos.capacity() * sizeof(uint32_t);
+        ret += tree.capacity() * sizeof(double);
         //ret += vars.capacity() * sizeof(uint32_t);
         return ret;
     }
 
     void build(const vector<uint32_t>& vs) {
-        in_heap.clear();
         uint32_t max = 0;
         for(const auto x: vs) {
             max = std::max(x, max);
         }
-        in_heap.resize(max+1, false);
-        vars.clear();
-        std::copy(
-            vs.begin(),
-            vs.end(),
-            std::inserter(vars, vars.end()));
-        for(const auto& x: vars) {
-            in_heap[x] = true;
+        pos.clear();
+        pos.resize(max+1, var_Undef);
+        vars = vs;
+        boundary = 0;
+        std::fill(lim.begin(), lim.end(), 0);
+        for(uint32_t i = 0; i < vars.size(); i++) {
+            pos[vars[i]] = i;
+        }
+        if (weights) {
+            build_tree();
         }
     }
 
     bool heap_property() const
     {
-        for(const auto& x: vars) {
-            if (!in_heap[x]) {
+        for(uint32_t i = 0; i < vars.size(); i++) {
+            if (!inHeap(vars[i]) || pos[vars[i]] != i) {
                 return false;
             }
         }
@@ -144,20 +223,89 @@ struct RandHeap
         return true;
     }
 
-    uint32_t get_random_element(std::mt19937_64& mtrand)
+    //Switches to weighted picking. Weights must be positive and must not
+    //change while the var is inside
+    void set_weights(const vector<double>* _weights)
+    {
+        weights = _weights;
+        build_tree();
+    }
+
+    uint32_t get_random_element(RandGen& mtrand)
     {
-        if (vars.empty()) {
+        if (boundary == vars.size()) {
             return var_Undef;
         }
 
-        uint32_t which = rnd_uint(mtrand, vars.size()-1);
-        uint32_t picked = vars[which];
-        std::swap(vars[which], vars[vars.size()-1]);
-        vars.pop_back();
-        assert(inHeap(picked));
-        in_heap[picked] = false;
+        if (weights) {
+            const uint32_t picked = tree_find(mtrand);
+            //Rounding errors could point us to a var that's not free
+            if (inHeap(picked) && pos[picked] >= boundary) {
+                return picked;
+            }
+        }
+        return vars[boundary + rnd_uint(mtrand, vars.size()-boundary-1)];
+    }
+
+private:
+    //Fills the hole at "to" with the var at "from"
+    void move(const uint32_t from, const uint32_t to)
+    {
+        if (from == to) {
+            return;
+        }
+        const uint32_t x = vars[from];
+        vars[to] = x;
+        pos[x] = to;
+    }
+
+    void build_tree()
+    {
+        size_t cap = 1;
+        while(cap < std::max(pos.size(), weights->size())) {
+            cap *= 2;
+        }
+        tree.clear();
+        tree.resize(cap+1, 0);
+        for(uint32_t i = boundary; i < vars.size(); i++) {
+            tree[vars[i]+1] += (*weights)[vars[i]];
+        }
+        for(size_t i = 1; i <= cap; i++) {
+            const size_t parent = i + (i & (0-i));
+            if (parent <= cap) {
+                tree[parent] += tree[i];
+            }
+        }
+    }
 
-        return picked;
+    void tree_add(uint32_t x, const double w)
+    {
+        if (x+1 >= tree.size()) {
+            //Amortised, the size doubles
+            build_tree();
+            return;
+        }
+        for(size_t i = x+1; i < tree.size(); i += i & (0-i)) {
+            tree[i] += w;
+        }
+    }
+
+    uint32_t tree_find(RandGen& mtrand) const
+    {
+        const size_t cap = tree.size()-1;
+        const double total = tree[cap];
+        if (!(total > 0)) {
+            return var_Undef;
+        }
+        double r = mtrand.rnd_double() * total;
+        size_t at = 0;
+        for(size_t step = cap; step > 0; step /= 2) {
+            if (at + step <= cap && tree[at + step] <= r) {
+                at += step;
+                r -= tree[at];
+            }
+        }
+        return at;
     }
 };
 
@@ -201,8 +349,9 @@ public:
     void new_decision_level();
     vector<double> var_act_vsids;
     vector<double> var_act_maple;
+    vector<double> var_branch_weight;
 
-    ///activity-ordered heap of decision variables.
+    ///unassigned decision variables, picked at random.
     ///NOT VALID WHILE SIMPLIFYING
     RandHeap order_heap_rand;
     double max_vsids_act = 0.0;
@@ -343,6 +492,7 @@ private:
 inline void PropEngine::new_decision_level()
 {
     trail_lim.push_back(trail.size());
+    order_heap_rand.new_level();
     #ifdef VERBOSE_DEBUG
     cout << "New decision level: " << trail_lim.size() << endl;
     #endif
@@ -480,6 +630,7 @@ void PropEngine::enqueue(const Lit p, const PropBy from)
     if (!update_bogoprops) {
         varData[v].polarity = !sign;
     }
+    order_heap_rand.assigned(v);
     trail.push_back(p);
 
     if (update_bogoprops) {
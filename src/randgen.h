@@ -0,0 +1,182 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef RANDGEN_H
+#define RANDGEN_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace CMSGen {
+
+enum class RandGenType { xoshiro, mt };
+
+inline std::string getNameOfRandGenType(RandGenType t)
+{
+    switch(t) {
+        case RandGenType::xoshiro:
+            return "xoshiro";
+
+        case RandGenType::mt:
+            return "mt";
+    }
+
+    return "unknown";
+}
+
+/**
+@brief Random number generator of the solver
+
+The default backend is xoshiro256** run as 4 independent streams whose state
+is laid out lane by lane, so the compiler vectorizes the loop that refills a
+block of words, and draws are served from that block. The Mersenne Twister
+backend draws exactly as the solver did before, so earlier results can be
+reproduced with it.
+
+It's a UniformRandomBitGenerator, so std::shuffle & co. can use it.
+*/
+class RandGen
+{
+public:
+    typedef uint64_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+
+    explicit RandGen(uint64_t _seed = 0, RandGenType _type = RandGenType::xoshiro)
+    {
+        seed(_seed, _type);
+    }
+
+    void seed(uint64_t _seed)
+    {
+        seed(_seed, type);
+    }
+
+    void seed(uint64_t _seed, RandGenType _type)
+    {
+        type = _type;
+        if (type == RandGenType::mt) {
+            mt.seed(_seed);
+        } else {
+            uint64_t x = _seed;
+            for(uint32_t i = 0; i < 4; i++) {
+                for(uint32_t l = 0; l < lanes; l++) {
+                    s[i][l] = splitmix64(x);
+                }
+            }
+        }
+        at = block_size;
+    }
+
+    RandGenType get_type() const
+    {
+        return type;
+    }
+
+    result_type operator()()
+    {
+        if (type == RandGenType::mt) {
+            return mt();
+        }
+        if (at == block_size) {
+            refill();
+        }
+        return block[at++];
+    }
+
+    //Uniform in [0, maximum]
+    uint32_t rnd_uint(const uint32_t maximum)
+    {
+        if (type == RandGenType::mt) {
+            std::uniform_int_distribution<> u(0, maximum);
+            return u(mt);
+        }
+
+        //Lemire's multiply-shift, with rejection to stay unbiased
+        const uint64_t range = (uint64_t)maximum + 1;
+        uint64_t m = (uint64_t)(uint32_t)((*this)() >> 32) * range;
+        if ((uint32_t)m < range) {
+            const uint32_t threshold = ((1ULL << 32) - range) % range;
+            while((uint32_t)m < threshold) {
+                m = (uint64_t)(uint32_t)((*this)() >> 32) * range;
+            }
+        }
+        return m >> 32;
+    }
+
+    //Uniform in [0, 1)
+    double rnd_double()
+    {
+        if (type == RandGenType::mt) {
+            std::uniform_real_distribution<double> unif_dbl(0.0, 1.0);
+            return unif_dbl(mt);
+        }
+        return ((*this)() >> 11) * 0x1.0p-53;
+    }
+
+private:
+    static const uint32_t lanes = 4;
+    static const size_t block_size = 256;
+
+    static uint64_t splitmix64(uint64_t& x)
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    static uint64_t rotl(const uint64_t x, const int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    void refill()
+    {
+        for(size_t i = 0; i < block_size; i += lanes) {
+            for(uint32_t l = 0; l < lanes; l++) {
+                block[i+l] = rotl(s[1][l] * 5, 7) * 9;
+                const uint64_t t = s[1][l] << 17;
+                s[2][l] ^= s[0][l];
+                s[3][l] ^= s[1][l];
+                s[1][l] ^= s[2][l];
+                s[0][l] ^= s[3][l];
+                s[2][l] ^= t;
+                s[3][l] = rotl(s[3][l], 45);
+            }
+        }
+        at = 0;
+    }
+
+    RandGenType type = RandGenType::xoshiro;
+    uint64_t s[4][lanes];
+    std::mt19937_64 mt;
+    uint64_t block[block_size];
+    size_t at = block_size;
+};
+
+}
+
+#endif //RANDGEN_H
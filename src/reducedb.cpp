@@ -40,7 +40,7 @@ struct SortRedClsGlue
     {
         const Clause* x = cl_alloc.ptr(xOff);
         const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.glue < y->stats.glue;
+        return cl_alloc.stats(x).glue < cl_alloc.stats(y).glue;
     }
 };
 
@@ -70,7 +70,7 @@ struct SortRedClsAct
     {
         const Clause* x = cl_alloc.ptr(xOff);
         const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.activity > y->stats.activity;
+        return cl_alloc.stats(x).activity > cl_alloc.stats(y).activity;
     }
 };
 
@@ -167,20 +167,21 @@ void ReduceDB::handle_lev1()
     ) {
         const ClOffset offset = solver->longRedCls[1][i];
         Clause* cl = solver->cl_alloc.ptr(offset);
-        if (cl->stats.which_red_array == 0) {
+        ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
+        if (cl_stats.which_red_array == 0) {
             solver->longRedCls[0].push_back(offset);
             moved_w0++;
-        } else if (cl->stats.which_red_array == 2) {
+        } else if (cl_stats.which_red_array == 2) {
             assert(false && "we should never move up through any other means");
         } else {
             uint32_t must_touch = solver->conf.must_touch_lev1_within;
-            if (cl->stats.drop_if_not_used) {
+            if (cl_stats.drop_if_not_used) {
                 must_touch *= solver->conf.ternary_keep_mult;
             }
             if (!solver->clause_locked(*cl, offset)
-                && cl->stats.last_touched + must_touch < solver->sumConflicts
+                && cl_stats.last_touched + must_touch < solver->sumConflicts
             ) {
-                if (cl->stats.drop_if_not_used) {
+                if (cl_stats.drop_if_not_used) {
                     solver->watches.smudge((*cl)[0]);
                     solver->watches.smudge((*cl)[1]);
                     non_recent_use_dropped++;
@@ -190,19 +191,19 @@ void ReduceDB::handle_lev1()
                     delayed_clause_free.push_back(offset);
                 } else {
                     solver->longRedCls[2].push_back(offset);
-                    cl->stats.which_red_array = 2;
+                    cl_stats.which_red_array = 2;
 
                     //when stats are needed, activities are correctly updated
                     //across all clauses
                     //WARNING this changes the way things behave during STATS relative to non-STATS!
-                    cl->stats.activity = 0;
+                    cl_stats.activity = 0;
                     solver->bump_cl_act<false>(cl);
                     non_recent_use++;
                 }
             } else {
                 solver->longRedCls[1][j++] = offset;
                 used_recently++;
-                if (cl->stats.drop_if_not_used) {
+                if (cl_stats.drop_if_not_used) {
                     kept_droppable++;
                 }
             }
@@ -239,19 +240,20 @@ void ReduceDB::mark_top_N_clauses(const uint64_t keep_num)
     ) {
         const ClOffset offset = solver->longRedCls[2][i];
         Clause* cl = solver->cl_alloc.ptr(offset);
+        ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
 
         if (cl->used_in_xor()
-            || cl->stats.ttl > 0
+            || cl_stats.ttl > 0
             || solver->clause_locked(*cl, offset)
-            || cl->stats.which_red_array != 2
+            || cl_stats.which_red_array != 2
         ) {
             //no need to mark, skip
             continue;
         }
 
-        if (!cl->stats.marked_clause) {
+        if (!cl_stats.marked_clause) {
             marked++;
-            cl->stats.marked_clause = true;
+            cl_stats.marked_clause = true;
         }
     }
 }
@@ -259,9 +261,10 @@ void ReduceDB::mark_top_N_clauses(const uint64_t keep_num)
 bool ReduceDB::cl_needs_removal(const Clause* cl, const ClOffset offset) const
 {
     assert(cl->red());
+    const ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
     return !cl->used_in_xor()
-         && !cl->stats.marked_clause
-         && cl->stats.ttl == 0
+         && !cl_stats.marked_clause
+         && cl_stats.ttl == 0
          && !solver->clause_locked(*cl, offset);
 }
 
@@ -273,31 +276,32 @@ void ReduceDB::remove_cl_from_lev2() {
     ) {
         ClOffset offset = solver->longRedCls[2][i];
         Clause* cl = solver->cl_alloc.ptr(offset);
+        ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
         assert(cl->size() > 2);
 
         //move to another array
-        if (cl->stats.which_red_array < 2) {
-            cl->stats.marked_clause = 0;
-            solver->longRedCls[cl->stats.which_red_array].push_back(offset);
+        if (cl_stats.which_red_array < 2) {
+            cl_stats.marked_clause = 0;
+            solver->longRedCls[cl_stats.which_red_array].push_back(offset);
             continue;
         }
-        assert(cl->stats.which_red_array == 2);
+        assert(cl_stats.which_red_array == 2);
 
         //Check if locked, or marked or ttl-ed
-        if (cl->stats.marked_clause) {
+        if (cl_stats.marked_clause) {
             cl_marked++;
-        } else if (cl->stats.ttl != 0) {
+        } else if (cl_stats.ttl != 0) {
             cl_ttl++;
         } else if (solver->clause_locked(*cl, offset)) {
             cl_locked_solver++;
         }
 
         if (!cl_needs_removal(cl, offset)) {
-            if (cl->stats.ttl > 0) {
-                cl->stats.ttl--;
+            if (cl_stats.ttl > 0) {
+                cl_stats.ttl--;
             }
             solver->longRedCls[2][j++] = offset;
-            cl->stats.marked_clause = 0;
+            cl_stats.marked_clause = 0;
             continue;
         }
 
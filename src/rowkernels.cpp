@@ -0,0 +1,265 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "rowkernels.h"
+#include "popcnt.h"
+
+//The vector kernels are compiled with per-function target attributes, so
+//the rest of the library needs no -mavx2 and runs on any x86-64
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ROW_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+using namespace CMSGen;
+
+static void xor_words_scalar(uint64_t* __restrict a, const uint64_t* __restrict b, uint32_t words)
+{
+    for(uint32_t i = 0; i < words; i++) {
+        a[i] ^= b[i];
+    }
+}
+
+static uint32_t xor_words_popcnt_scalar(uint64_t* __restrict a, const uint64_t* __restrict b, uint32_t words)
+{
+    uint32_t ret = 0;
+    for(uint32_t i = 0; i < words; i++) {
+        a[i] ^= b[i];
+        ret += my_popcnt64(a[i]);
+    }
+    return ret;
+}
+
+static uint32_t popcnt_words_scalar(const uint64_t* a, uint32_t words)
+{
+    uint32_t ret = 0;
+    for(uint32_t i = 0; i < words; i++) {
+        ret += my_popcnt64(a[i]);
+    }
+    return ret;
+}
+
+static uint32_t first_nonzero_word_scalar(const uint64_t* a, uint32_t from, uint32_t words)
+{
+    for(uint32_t i = from; i < words; i++) {
+        if (a[i]) {
+            return i;
+        }
+    }
+    return words;
+}
+
+static const RowKernels scalar_kernels = {
+    "scalar"
+    , xor_words_scalar
+    , xor_words_popcnt_scalar
+    , popcnt_words_scalar
+    , first_nonzero_word_scalar
+};
+
+#ifdef ROW_KERNELS_X86
+
+//Bits set in each 64-bit lane, via a nibble lookup table (no popcnt in AVX2)
+__attribute__((target("avx2")))
+static inline __m256i popcnt_lanes_avx2(const __m256i v)
+{
+    const __m256i lut = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+        , 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_and_si256(v, low_mask);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    const __m256i cnt = _mm256_add_epi8(
+        _mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2")))
+static uint32_t sum_lanes_avx2(const __m256i v)
+{
+    const __m128i s = _mm_add_epi64(
+        _mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1);
+}
+
+__attribute__((target("avx2")))
+static void xor_words_avx2(uint64_t* a, const uint64_t* b, uint32_t words)
+{
+    for(uint32_t i = 0; i < words; i += 4) {
+        const __m256i x = _mm256_load_si256((const __m256i*)(a + i));
+        const __m256i y = _mm256_load_si256((const __m256i*)(b + i));
+        _mm256_store_si256((__m256i*)(a + i), _mm256_xor_si256(x, y));
+    }
+}
+
+__attribute__((target("avx2")))
+static uint32_t xor_words_popcnt_avx2(uint64_t* a, const uint64_t* b, uint32_t words)
+{
+    __m256i sum = _mm256_setzero_si256();
+    for(uint32_t i = 0; i < words; i += 4) {
+        const __m256i x = _mm256_xor_si256(
+            _mm256_load_si256((const __m256i*)(a + i))
+            , _mm256_load_si256((const __m256i*)(b + i)));
+        _mm256_store_si256((__m256i*)(a + i), x);
+        sum = _mm256_add_epi64(sum, popcnt_lanes_avx2(x));
+    }
+    return sum_lanes_avx2(sum);
+}
+
+__attribute__((target("avx2")))
+static uint32_t popcnt_words_avx2(const uint64_t* a, uint32_t words)
+{
+    __m256i sum = _mm256_setzero_si256();
+    for(uint32_t i = 0; i < words; i += 4) {
+        const __m256i x = _mm256_load_si256((const __m256i*)(a + i));
+        sum = _mm256_add_epi64(sum, popcnt_lanes_avx2(x));
+    }
+    return sum_lanes_avx2(sum);
+}
+
+__attribute__((target("avx2")))
+static uint32_t first_nonzero_word_avx2(const uint64_t* a, uint32_t from, uint32_t words)
+{
+    uint32_t i = from;
+    for(; i < words && i % 4 != 0; i++) {
+        if (a[i]) {
+            return i;
+        }
+    }
+    for(; i < words; i += 4) {
+        const __m256i x = _mm256_load_si256((const __m256i*)(a + i));
+        if (!_mm256_testz_si256(x, x)) {
+            const __m256i zero = _mm256_cmpeq_epi64(x, _mm256_setzero_si256());
+            const uint32_t mask = ~_mm256_movemask_pd(_mm256_castsi256_pd(zero)) & 0xf;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return words;
+}
+
+static const RowKernels avx2_kernels = {
+    "avx2"
+    , xor_words_avx2
+    , xor_words_popcnt_avx2
+    , popcnt_words_avx2
+    , first_nonzero_word_avx2
+};
+
+__attribute__((target("avx512f")))
+static void xor_words_avx512(uint64_t* a, const uint64_t* b, uint32_t words)
+{
+    for(uint32_t i = 0; i < words; i += 8) {
+        const __m512i x = _mm512_load_si512(a + i);
+        const __m512i y = _mm512_load_si512(b + i);
+        _mm512_store_si512(a + i, _mm512_xor_si512(x, y));
+    }
+}
+
+//_mm512_reduce_add_epi64() trips -Wuninitialized inside GCC's own header
+__attribute__((target("avx512f")))
+static uint32_t sum_lanes_avx512(const __m512i v)
+{
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, v);
+    uint64_t ret = 0;
+    for(uint32_t i = 0; i < 8; i++) {
+        ret += lanes[i];
+    }
+    return ret;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static uint32_t xor_words_popcnt_avx512(uint64_t* a, const uint64_t* b, uint32_t words)
+{
+    __m512i sum = _mm512_setzero_si512();
+    for(uint32_t i = 0; i < words; i += 8) {
+        const __m512i x = _mm512_xor_si512(
+            _mm512_load_si512(a + i), _mm512_load_si512(b + i));
+        _mm512_store_si512(a + i, x);
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(x));
+    }
+    return sum_lanes_avx512(sum);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static uint32_t popcnt_words_avx512(const uint64_t* a, uint32_t words)
+{
+    __m512i sum = _mm512_setzero_si512();
+    for(uint32_t i = 0; i < words; i += 8) {
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_load_si512(a + i)));
+    }
+    return sum_lanes_avx512(sum);
+}
+
+__attribute__((target("avx512f")))
+static uint32_t first_nonzero_word_avx512(const uint64_t* a, uint32_t from, uint32_t words)
+{
+    uint32_t i = from;
+    for(; i < words && i % 8 != 0; i++) {
+        if (a[i]) {
+            return i;
+        }
+    }
+    for(; i < words; i += 8) {
+        const __m512i x = _mm512_load_si512(a + i);
+        const __mmask8 nonzero = _mm512_test_epi64_mask(x, x);
+        if (nonzero) {
+            return i + __builtin_ctz(nonzero);
+        }
+    }
+    return words;
+}
+
+static const RowKernels avx512_kernels = {
+    "avx512"
+    , xor_words_avx512
+    , xor_words_popcnt_avx512
+    , popcnt_words_avx512
+    , first_nonzero_word_avx512
+};
+
+#endif //ROW_KERNELS_X86
+
+std::vector<const RowKernels*> CMSGen::supported_row_kernels()
+{
+    std::vector<const RowKernels*> ret;
+    #ifdef ROW_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")
+        && __builtin_cpu_supports("avx512vpopcntdq")
+    ) {
+        ret.push_back(&avx512_kernels);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        ret.push_back(&avx2_kernels);
+    }
+    #endif
+    ret.push_back(&scalar_kernels);
+    return ret;
+}
+
+const RowKernels* CMSGen::row_kernels = supported_row_kernels().front();
+
+void CMSGen::set_row_kernels(const RowKernels* kernels)
+{
+    row_kernels = kernels;
+}
@@ -0,0 +1,77 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef ROWKERNELS_H
+#define ROWKERNELS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CMSGen {
+
+//Rows of a PackedMatrix start on a 64-byte boundary and their words are
+//zero-padded to a multiple of row_align_words, so the kernels below run
+//whole vectors with aligned loads and never need a tail loop
+static const uint32_t row_align_words = 8;
+
+inline uint32_t row_padded_words(const uint32_t words)
+{
+    return (words + row_align_words - 1) & ~(row_align_words - 1);
+}
+
+/**
+@brief The word loops of Gauss-Jordan elimination over GF(2)
+
+"words" is always a multiple of row_align_words and the pointers are
+64-byte aligned. One set of kernels is picked at startup according to the
+CPU: AVX-512, AVX2, or plain scalar code.
+*/
+struct RowKernels
+{
+    const char* name;
+
+    ///a ^= b
+    void (*xor_words)(uint64_t* a, const uint64_t* b, uint32_t words);
+
+    ///a ^= b, returns the number of bits set in the result
+    uint32_t (*xor_words_popcnt)(uint64_t* a, const uint64_t* b, uint32_t words);
+
+    ///Number of bits set
+    uint32_t (*popcnt_words)(const uint64_t* a, uint32_t words);
+
+    ///Index of the first non-zero word at or after "from", "words" if none
+    uint32_t (*first_nonzero_word)(const uint64_t* a, uint32_t from, uint32_t words);
+};
+
+///The kernels in use
+extern const RowKernels* row_kernels;
+
+///All kernels the CPU can run, fastest first. The last one is scalar
+std::vector<const RowKernels*> supported_row_kernels();
+
+///Overrides the kernels picked at startup, e.g. to compare them
+void set_row_kernels(const RowKernels* kernels);
+
+}
+
+#endif //ROWKERNELS_H
@@ -0,0 +1,309 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef SAMPLEFILE_H
+#define SAMPLEFILE_H
+
+//Binary sample file, as written by "cmsgen --sampleformat bin"
+//
+//All integers are little-endian uint32_t:
+//  magic "CMSGSMPL", version, num_vars, bytes_per_sample, flags,
+//  then num_vars variable numbers (1-based, as in DIMACS)
+//followed by the samples, bytes_per_sample bytes each, until end of file.
+//Bit i of a sample is at sample[i/8] & (1<<(i%8)), set iff the i-th
+//variable of the header is TRUE. The header is padded to 8 bytes.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <ostream>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "solvertypesmini.h"
+
+namespace CMSGen {
+
+static const char sample_file_magic[8] = {'C','M','S','G','S','M','P','L'};
+static const uint32_t sample_file_version = 1;
+static const uint32_t sample_file_only_sampling = 1;
+
+inline size_t sample_file_header_bytes(size_t num_vars)
+{
+    const size_t sz = sizeof(sample_file_magic) + 4*4 + 4*num_vars;
+    return (sz+7) & ~(size_t)7;
+}
+
+class SampleFileWriter
+{
+public:
+    //vars are 0-based, the i-th sample bit is the value of vars[i]
+    SampleFileWriter(
+        std::ostream* _os
+        , const std::vector<uint32_t>& _vars
+        , uint32_t flags = 0
+        , size_t buf_bytes = 1ULL << 20
+    ) :
+        os(_os)
+        , vars(_vars)
+        , bytes_per_sample((_vars.size()+7)/8)
+    {
+        const size_t hdr_bytes = sample_file_header_bytes(vars.size());
+        buf.reserve(std::max(buf_bytes, hdr_bytes) + bytes_per_sample);
+        buf.resize(hdr_bytes, 0);
+        uint8_t* at = buf.data();
+        memcpy(at, sample_file_magic, sizeof(sample_file_magic));
+        at += sizeof(sample_file_magic);
+        at = put_uint32_t(at, sample_file_version);
+        at = put_uint32_t(at, vars.size());
+        at = put_uint32_t(at, bytes_per_sample);
+        at = put_uint32_t(at, flags);
+        for(const uint32_t var: vars) {
+            at = put_uint32_t(at, var+1);
+        }
+        max_buf_bytes = std::max(buf_bytes, hdr_bytes);
+    }
+
+    ~SampleFileWriter()
+    {
+        flush();
+    }
+
+    void add(const std::vector<lbool>& model)
+    {
+        const size_t at = buf.size();
+        buf.resize(at + bytes_per_sample, 0);
+        uint8_t* out = buf.data() + at;
+        for(size_t i = 0; i < vars.size(); i++) {
+            if (model[vars[i]] == l_True) {
+                out[i/8] |= 1U << (i%8);
+            }
+        }
+        if (buf.size() >= max_buf_bytes) {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        if (buf.empty()) {
+            return;
+        }
+        os->write((const char*)buf.data(), buf.size());
+        buf.clear();
+    }
+
+private:
+    static uint8_t* put_uint32_t(uint8_t* at, uint32_t val)
+    {
+        for(uint32_t i = 0; i < 4; i++) {
+            at[i] = (val >> (8*i)) & 0xff;
+        }
+        return at+4;
+    }
+
+    std::ostream* os;
+    const std::vector<uint32_t> vars;
+    const size_t bytes_per_sample;
+    size_t max_buf_bytes;
+    std::vector<uint8_t> buf;
+};
+
+//Decoder. Maps the file into memory where possible, so samples are never
+//copied: sample(i) points straight into the file.
+class SampleFileReader
+{
+public:
+    SampleFileReader() = default;
+    SampleFileReader(const SampleFileReader&) = delete;
+    SampleFileReader& operator=(const SampleFileReader&) = delete;
+    ~SampleFileReader()
+    {
+        close();
+    }
+
+    //Returns false and sets error() if the file cannot be read
+    bool open(const std::string& fname)
+    {
+        close();
+        #ifndef _WIN32
+        int fd = ::open(fname.c_str(), O_RDONLY);
+        if (fd < 0) {
+            err = "could not open file '" + fname + "'";
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            err = "could not stat file '" + fname + "'";
+            return false;
+        }
+        file_bytes = st.st_size;
+        if (file_bytes > 0) {
+            void* p = mmap(NULL, file_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                err = "could not mmap file '" + fname + "'";
+                return false;
+            }
+            mapped = (const uint8_t*)p;
+            madvise(p, file_bytes, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+        data = mapped;
+        #else
+        FILE* f = fopen(fname.c_str(), "rb");
+        if (f == NULL) {
+            err = "could not open file '" + fname + "'";
+            return false;
+        }
+        uint8_t tmp[1 << 16];
+        size_t num;
+        while((num = fread(tmp, 1, sizeof(tmp), f)) > 0) {
+            copied.insert(copied.end(), tmp, tmp+num);
+        }
+        fclose(f);
+        file_bytes = copied.size();
+        data = copied.data();
+        #endif
+        return parse_header();
+    }
+
+    void close()
+    {
+        #ifndef _WIN32
+        if (mapped != NULL) {
+            munmap((void*)mapped, file_bytes);
+        }
+        mapped = NULL;
+        #else
+        copied.clear();
+        #endif
+        data = NULL;
+        file_bytes = 0;
+        vars.clear();
+    }
+
+    uint32_t num_vars() const { return vars.size(); }
+    uint64_t num_samples() const { return n_samples; }
+    size_t get_bytes_per_sample() const { return bytes_per_sample; }
+    bool only_sampling_vars() const { return flags & sample_file_only_sampling; }
+    const std::string& error() const { return err; }
+
+    //1-based variable number of the i-th bit of each sample
+    uint32_t var(uint32_t i) const { return vars[i]; }
+    const uint8_t* sample(uint64_t s) const
+    {
+        return data + samples_start + s*bytes_per_sample;
+    }
+    bool value(uint64_t s, uint32_t i) const
+    {
+        return (sample(s)[i/8] >> (i%8)) & 1;
+    }
+
+    //Sample as DIMACS-style literals over the header's variables
+    void get_lits(uint64_t s, std::vector<int>& lits) const
+    {
+        lits.resize(vars.size());
+        for(uint32_t i = 0; i < vars.size(); i++) {
+            lits[i] = value(s, i) ? (int)vars[i] : -(int)vars[i];
+        }
+    }
+
+private:
+    static uint32_t get_uint32_t(const uint8_t* at)
+    {
+        return (uint32_t)at[0]
+            | ((uint32_t)at[1] << 8)
+            | ((uint32_t)at[2] << 16)
+            | ((uint32_t)at[3] << 24);
+    }
+
+    bool parse_header()
+    {
+        const size_t fixed = sizeof(sample_file_magic) + 4*4;
+        if (file_bytes < fixed
+            || memcmp(data, sample_file_magic, sizeof(sample_file_magic)) != 0
+        ) {
+            err = "not a CMSGen binary sample file";
+            return false;
+        }
+        const uint8_t* at = data + sizeof(sample_file_magic);
+        const uint32_t version = get_uint32_t(at);
+        const uint32_t nvars = get_uint32_t(at+4);
+        bytes_per_sample = get_uint32_t(at+8);
+        flags = get_uint32_t(at+12);
+        if (version != sample_file_version) {
+            err = "unsupported sample file version " + std::to_string(version);
+            return false;
+        }
+        samples_start = sample_file_header_bytes(nvars);
+        if (file_bytes < samples_start
+            || bytes_per_sample != (nvars+7)/8
+        ) {
+            err = "corrupt sample file header";
+            return false;
+        }
+        at += 16;
+        vars.resize(nvars);
+        for(uint32_t i = 0; i < nvars; i++) {
+            vars[i] = get_uint32_t(at + 4*i);
+        }
+        const size_t body = file_bytes - samples_start;
+        if (bytes_per_sample == 0) {
+            n_samples = 0;
+        } else {
+            if (body % bytes_per_sample != 0) {
+                err = "sample file is truncated";
+                return false;
+            }
+            n_samples = body / bytes_per_sample;
+        }
+        return true;
+    }
+
+    const uint8_t* data = NULL;
+    size_t file_bytes = 0;
+    #ifndef _WIN32
+    const uint8_t* mapped = NULL;
+    #else
+    std::vector<uint8_t> copied;
+    #endif
+    std::vector<uint32_t> vars;
+    size_t bytes_per_sample = 0;
+    size_t samples_start = 0;
+    uint64_t n_samples = 0;
+    uint32_t flags = 0;
+    std::string err;
+};
+
+}
+
+#endif //SAMPLEFILE_H
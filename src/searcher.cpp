@@ -75,7 +75,7 @@ Searcher::Searcher(const SolverConf *_conf, Solver* _solver, std::atomic<bool>*
     var_inc_vsids = conf.var_inc_vsids_start;
     more_red_minim_limit_binary_actual = conf.more_red_minim_limit_binary;
     more_red_minim_limit_cache_actual = conf.more_red_minim_limit_cache;
-    mtrand.seed(conf.origSeed);
+    mtrand.seed(conf.origSeed, conf.rand_gen);
     hist.setSize(conf.shortTermHistorySize, conf.blocking_restart_trail_hist_length);
     cur_max_temp_red_lev2_cls = conf.max_temp_lev2_learnt_clauses;
 }
@@ -93,6 +93,7 @@ void Searcher::new_var(const bool bva, const uint32_t orig_outer)
 
     var_act_vsids.push_back(0);
     var_act_maple.push_back(0);
+    var_branch_weight.push_back(1.0);
     insert_var_order_all((int)nVars()-1);
 }
 
@@ -102,6 +103,7 @@ void Searcher::new_vars(size_t n)
 
     var_act_vsids.insert(var_act_vsids.end(), n, 0);
     var_act_maple.insert(var_act_maple.end(), n, 0);
+    var_branch_weight.insert(var_branch_weight.end(), n, 1.0);
     for(int i = n-1; i >= 0; i--) {
         insert_var_order_all((int)nVars()-i-1);
     }
@@ -113,9 +115,11 @@ void Searcher::save_on_var_memory()
 
     var_act_vsids.resize(nVars());
     var_act_maple.resize(nVars());
+    var_branch_weight.resize(nVars());
 
     var_act_vsids.shrink_to_fit();
     var_act_maple.shrink_to_fit();
+    var_branch_weight.shrink_to_fit();
 
 }
 
@@ -125,6 +129,7 @@ void Searcher::updateVars(
 ) {
     updateArray(var_act_vsids, interToOuter);
     updateArray(var_act_maple, interToOuter);
+    updateArray(var_branch_weight, interToOuter);
 }
 
 template<bool update_bogoprops>
@@ -353,26 +358,27 @@ void Searcher::update_clause_glue_from_analysis(Clause* cl)
 {
     assert(cl->red());
     const unsigned new_glue = calc_glue(*cl);
+    ClauseStats& cl_stats = cl_alloc.stats(cl);
 
-    if (new_glue < cl->stats.glue) {
-        if (cl->stats.glue <= conf.protect_cl_if_improved_glue_below_this_glue_for_one_turn) {
-            cl->stats.ttl = 1;
+    if (new_glue < cl_stats.glue) {
+        if (cl_stats.glue <= conf.protect_cl_if_improved_glue_below_this_glue_for_one_turn) {
+            cl_stats.ttl = 1;
         }
-        cl->stats.glue = new_glue;
+        cl_stats.glue = new_glue;
 
-        if (cl->stats.locked_for_data_gen) {
-            assert(cl->stats.which_red_array == 0);
+        if (cl_stats.locked_for_data_gen) {
+            assert(cl_stats.which_red_array == 0);
         } else if (new_glue <= conf.glue_put_lev0_if_below_or_eq
-            && cl->stats.which_red_array >= 1
+            && cl_stats.which_red_array >= 1
         ) {
             //move to lev0 if very low glue
-            cl->stats.which_red_array = 0;
+            cl_stats.which_red_array = 0;
         } else {
             //move to lev1 if low glue
             if (new_glue <= conf.glue_put_lev1_if_below_or_eq
                 && solver->conf.glue_put_lev1_if_below_or_eq != 0
             ) {
-                cl->stats.which_red_array = 1;
+                cl_stats.which_red_array = 1;
             }
         }
      }
@@ -409,19 +415,20 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
                 stats.resolvs.longIrred++;
             }
 
+            ClauseStats& cl_stats = cl_alloc.stats(cl);
             if (!update_bogoprops
                 && cl->red()
-                && cl->stats.which_red_array != 0
+                && cl_stats.which_red_array != 0
             ) {
                 if (conf.update_glues_on_analyze) {
                     update_clause_glue_from_analysis(cl);
                 }
-                cl->stats.last_touched = sumConflicts;
+                cl_stats.last_touched = sumConflicts;
 
                 //If stats or predictor, bump all because during final
                 //we will need this data and during dump when stats is on
                 //we also need this data.
-                if (cl->stats.which_red_array == 2) {
+                if (cl_stats.which_red_array == 2) {
                     bump_cl_act<update_bogoprops>(cl);
                 }
             }
@@ -603,7 +610,7 @@ inline Clause* Searcher::create_learnt_clause(PropBy confl)
             //A long clause
             && last_resolved_cl != NULL
             //Good enough clause to try to minimize
-            && (!last_resolved_cl->red() || last_resolved_cl->stats.glue <= conf.doOTFSubsumeOnlyAtOrBelowGlue)
+            && (!last_resolved_cl->red() || cl_alloc.stats(last_resolved_cl).glue <= conf.doOTFSubsumeOnlyAtOrBelowGlue)
             //Must subsume, so must be smaller
             && last_resolved_cl->size() > tmp_learnt_clause_size
             //Must not be a temporary clause
@@ -1448,16 +1455,8 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
             << fin;
             cl = NULL;
         } else {
-            cl = cl_alloc.Clause_new(learnt_clause
-            , sumConflicts
-            );
-            cl->makeRed(glue);
-            ClOffset offset = cl_alloc.get_offset(cl);
             unsigned which_arr = 2;
-
-            if (cl->stats.locked_for_data_gen) {
-                which_arr = 0;
-            } else if (glue <= conf.glue_put_lev0_if_below_or_eq) {
+            if (glue <= conf.glue_put_lev0_if_below_or_eq) {
                 which_arr = 0;
             } else if (
                 glue <= conf.glue_put_lev1_if_below_or_eq
@@ -1468,13 +1467,26 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
                 which_arr = 2;
             }
 
+            cl = cl_alloc.Clause_new(learnt_clause
+            , sumConflicts
+            , red_cl_region(which_arr)
+            );
+            cl->makeRed();
+            ClauseStats& cl_stats = cl_alloc.stats(cl);
+            cl_stats.glue = glue;
+            cl_stats.activity = 0.0;
+            ClOffset offset = cl_alloc.get_offset(cl);
+            if (cl_stats.locked_for_data_gen) {
+                which_arr = 0;
+            }
+
             if (which_arr == 0) {
                 stats.red_cl_in_which0++;
             }
 
-            cl->stats.which_red_array = which_arr;
-            cl->stats.is_decision_cl = decision_cl;
-            solver->longRedCls[cl->stats.which_red_array].push_back(offset);
+            cl_stats.which_red_array = which_arr;
+            cl_stats.is_decision_cl = decision_cl;
+            solver->longRedCls[cl_stats.which_red_array].push_back(offset);
 
             *drat << add << *cl
             << fin;
@@ -1494,8 +1506,9 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
         assert(cl->size() == learnt_clause.size());
 
         //Update stats
-        if (cl->red() && cl->stats.glue > glue) {
-            cl->stats.glue = glue;
+        ClauseStats& cl_stats = cl_alloc.stats(cl);
+        if (cl->red() && cl_stats.glue > glue) {
+            cl_stats.glue = glue;
         }
 
         *drat << add << *cl
@@ -1726,20 +1739,21 @@ void Searcher::reduce_db_if_needed()
         && sumConflicts >= next_lev1_reduce
     ) {
         solver->reduceDB->handle_lev1();
+        cl_alloc.consolidate(solver, ClRegion::red1);
         next_lev1_reduce = sumConflicts + conf.every_lev1_reduce;
     }
 
     if (conf.every_lev2_reduce != 0) {
         if (sumConflicts >= next_lev2_reduce) {
             solver->reduceDB->handle_lev2();
-            cl_alloc.consolidate(solver);
+            cl_alloc.consolidate(solver, ClRegion::red2);
             next_lev2_reduce = sumConflicts + conf.every_lev2_reduce;
         }
     } else {
         if (longRedCls[2].size() > cur_max_temp_red_lev2_cls) {
             solver->reduceDB->handle_lev2();
             cur_max_temp_red_lev2_cls *= conf.inc_max_temp_lev2_red_cls;
-            cl_alloc.consolidate(solver);
+            cl_alloc.consolidate(solver, ClRegion::red2);
         }
     }
 }
@@ -1856,7 +1870,9 @@ lbool Searcher::solve(
     lbool status = l_Undef;
     if (conf.restartType == Restart::fixed) {
         params.rest_type = Restart::fixed;
-        max_confl_this_phase = conf.fixed_restart_num_confl;
+        if (!resume_search) {
+            max_confl_this_phase = conf.fixed_restart_num_confl;
+        }
     }
 
     #ifdef USE_GAUSS
@@ -1866,6 +1882,7 @@ lbool Searcher::solve(
         }
     } else {
         if (conf.verbosity >= 1) cout << "c [find&init matx] performing matrix init" << endl;
+        cancelUntil(0);
         clear_gauss_matrices();
         {
             MatrixFinder finder(solver);
@@ -1921,6 +1938,8 @@ lbool Searcher::solve(
                 status = l_False;
                 goto end;
             }
+            //Distillation doesn't put back the vars it unassigned
+            rebuildOrderHeap();
             next_distill = std::min<double>(sumConflicts * 0.2 + sumConflicts + 3000,
                                     sumConflicts + 50000);
         }
@@ -1991,7 +2010,15 @@ void Searcher::finish_up_solve(const lbool status)
         #ifdef SLOW_DEBUG
         check_order_heap_sanity();
         #endif
-        model = assigns;
+        if (model_proj) {
+            model_proj_vals.resize(model_proj->size());
+            for(size_t i = 0; i < model_proj->size(); i++) {
+                model_proj_vals[i] = value((*model_proj)[i]);
+                assert(model_proj_vals[i] != l_Undef);
+            }
+        } else {
+            model = assigns;
+        }
 
         if (conf.need_decisions_reaching) {
             for(size_t i = 0; i < trail_lim.size(); i++) {
@@ -2007,7 +2034,15 @@ void Searcher::finish_up_solve(const lbool status)
             }
         }
 
-        cancelUntil(0);
+        if (keep_trail_on_sat && decisionLevel() > 0) {
+            //The kept prefix is shared with the next sample, so consecutive
+            //samples are correlated and not uniform. That's why this is
+            //opt-in. Keeping at most half of the levels, picked independently
+            //of the decisions on them, limits how alike they get
+            cancelUntil(mtrand.rnd_uint(decisionLevel()/2));
+        } else {
+            cancelUntil(0);
+        }
         print_solution_varreplace_status();
     } else if (status == l_False) {
         if (conflict.size() == 0) {
@@ -2050,16 +2085,13 @@ Lit Searcher::pickBranchLit()
     #ifdef VERBOSE_DEBUG
     cout << "picking decision variable, dec. level: " << decisionLevel()
     #endif
-    uint32_t v = var_Undef;
-    while(true) {
+    //Only vars set during inprocessing can be inside while assigned
+    uint32_t v = order_heap_rand.get_random_element(mtrand);
+    while (v != var_Undef && value(v) != l_Undef) {
+        order_heap_rand.remove(v);
         v = order_heap_rand.get_random_element(mtrand);
-        while (v != var_Undef && value(v) != l_Undef) {
-            v = order_heap_rand.get_random_element(mtrand);
-        }
-        if (v == var_Undef) break;
-        assert(varData[v].removed == Removed::none);
-        break;
     }
+    assert(v == var_Undef || varData[v].removed == Removed::none);
 
     Lit next;
     if (v != var_Undef) {
@@ -2402,7 +2434,8 @@ Searcher::gauss_ret Searcher::gauss_jordan_elim()
 
                 Clause* conflPtr = solver->cl_alloc.Clause_new(
                     gqd.conflict_clause_gauss,
-                    sumConflicts
+                    sumConflicts,
+                    ClRegion::gauss_temp
                 );
 
                 conflPtr->set_gauss_temp_cl();
@@ -2682,6 +2715,10 @@ void Searcher::cancelUntil(uint32_t level
             }
         #endif //USE_GAUSS
 
+        //Vars of the heap assigned above "level" are free again. Only
+        //vars that were not in the heap need to be inserted one by one
+        order_heap_rand.backtrack(level);
+
         //Go through in reverse order, unassign & insert then
         //back to the vars to be branched upon
         for (int sublevel = trail.size()-1
@@ -83,6 +83,16 @@ class Searcher : public HyperEngine
 
 
         vector<lbool>  model;
+        //If set, a solution only records the value of these lits into
+        //model_proj_vals, instead of copying all of assigns into model
+        const vector<Lit>* model_proj = NULL;
+        vector<lbool>  model_proj_vals;
+        //Sample continuation (conf.sample_continue): if keep_trail_on_sat,
+        //a solution only backtracks to a random decision level. If
+        //resume_search, solve() carries on from that trail with the restart
+        //budget of the previous search instead of starting afresh
+        bool keep_trail_on_sat = false;
+        bool resume_search = false;
         vector<Lit>    decisions_reaching_model; // the decisions needed to reach current model
         bool           decisions_reaching_model_valid = false;
         vector<Lit>   conflict;     ///<If problem is unsatisfiable (possibly under assumptions), this vector represent the final conflict clause expressed in the assumptions.
@@ -405,6 +415,8 @@ class Searcher : public HyperEngine
 
         //Picking polarity when doing decision
         bool     pick_polarity(const uint32_t var);
+        uint64_t polar_rnd = 0; ///<Upper half is unused if polar_rnd_have_half
+        bool     polar_rnd_have_half = false;
 
         //Last time we clean()-ed the clauses, the number of zero-depth assigns was this many
         size_t   lastCleanZeroDepthAssigns;
@@ -457,16 +469,17 @@ inline void Searcher::bump_cl_act(Clause* cl)
 
     assert(!cl->getRemoved());
 
-    double new_val = cla_inc + (double)cl->stats.activity;
-    cl->stats.activity = (float)new_val;
+    ClauseStats& cl_stats = cl_alloc.stats(cl);
+    double new_val = cla_inc + (double)cl_stats.activity;
+    cl_stats.activity = (float)new_val;
     if (max_cl_act < new_val) {
         max_cl_act = new_val;
     }
 
 
-    if (cl->stats.activity > 1e20F ) {
+    if (cl_stats.activity > 1e20F ) {
         for(ClOffset offs: longRedCls[2]) {
-            cl_alloc.ptr(offs)->stats.activity *= static_cast<float>(1e-20);
+            cl_alloc.stats(cl_alloc.ptr(offs)).activity *= static_cast<float>(1e-20);
         }
         cla_inc *= 1e-20;
         max_cl_act *= 1e-20;
@@ -486,10 +499,24 @@ inline void Searcher::decayClauseAct()
 inline bool Searcher::pick_polarity(const uint32_t var)
 {
     switch(conf.polarity_mode) {
+        case PolarityMode::polarmode_weighted_fixed: {
+            //One 64-bit draw decides two polarities
+            uint32_t rnd;
+            if (polar_rnd_have_half) {
+                rnd = polar_rnd >> 32;
+                polar_rnd_have_half = false;
+            } else {
+                polar_rnd = mtrand();
+                rnd = (uint32_t)polar_rnd;
+                polar_rnd_have_half = true;
+            }
+            const uint32_t t = polar_threshold[var];
+            return rnd < t || t == std::numeric_limits<uint32_t>::max();
+        }
+
         case PolarityMode::polarmode_weighted: {
-            std::uniform_real_distribution<double> unif_dbl(0.0, 1.0);
-            double rnd = unif_dbl(mtrand);
-            return rnd < varData[var].weight;
+            double rnd = mtrand.rnd_double();
+            return rnd < polar_weight[var];
         }
 
         default:
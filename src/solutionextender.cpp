@@ -84,20 +84,11 @@ void SolutionExtender::extend()
     solver->varReplacer->extend_model_set_undef();
 }
 
+//Only reached with variable elimination (--varelim): the var was
+//eliminated and both of its values extend the model, so pick one at random
 lbool SolutionExtender::get_var_setting()
 {
-    assert(false && "not possible in CMSGen!!");
-    switch(solver->conf.polarity_mode) {
-        case PolarityMode::polarmode_weighted:
-            assert(false && "not possible in CMSGen!!");
-            return l_False;
-
-        default:
-            assert(false);
-    }
-    assert(false);
-    exit(-1);
-    return l_Undef;
+    return solver->mtrand.rnd_uint(1) ? l_True : l_False;
 }
 
 inline bool SolutionExtender::satisfied(const vector< Lit >& lits) const
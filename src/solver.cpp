@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include <limits>
 #include <string>
 #include <algorithm>
+#include <chrono>
 #include <vector>
 #include <complex>
 #include <locale>
@@ -377,11 +378,12 @@ Clause* Solver::add_clause_int(
         default:
             Clause* c = cl_alloc.Clause_new(ps
             , sumConflicts
+            , red ? red_cl_region(cl_stats.which_red_array) : ClRegion::irred
             );
             if (red) {
-                c->makeRed(cl_stats.glue);
+                c->makeRed();
             }
-            c->stats = cl_stats;
+            cl_alloc.stats(c) = cl_stats;
 
             //In class 'OccSimplifier' we don't need to attach normall
             if (attach_long) {
@@ -620,15 +622,16 @@ bool Solver::addClauseInt(vector<Lit>& ps, bool red)
         if (!red) {
             longIrredCls.push_back(offset);
         } else {
-            cl->stats.which_red_array = 2;
-            if (cl->stats.glue <= conf.glue_put_lev0_if_below_or_eq) {
-                cl->stats.which_red_array = 0;
-            } else if (cl->stats.glue <= conf.glue_put_lev1_if_below_or_eq
+            ClauseStats& cl_stats = cl_alloc.stats(cl);
+            cl_stats.which_red_array = 2;
+            if (cl_stats.glue <= conf.glue_put_lev0_if_below_or_eq) {
+                cl_stats.which_red_array = 0;
+            } else if (cl_stats.glue <= conf.glue_put_lev1_if_below_or_eq
                 && conf.glue_put_lev1_if_below_or_eq != 0
             ) {
-                cl->stats.which_red_array = 1;
+                cl_stats.which_red_array = 1;
             }
-            longRedCls[cl->stats.which_red_array].push_back(offset);
+            longRedCls[cl_stats.which_red_array].push_back(offset);
         }
     }
 
@@ -1100,7 +1103,15 @@ void Solver::extend_solution(const bool only_sampling_solution)
     }
     #endif
 
-    model = back_number_solution_from_inter_to_outer(model);
+    if (only_sampling_solution && model_proj) {
+        extend_projected_solution();
+        return;
+    }
+    model_is_projection = false;
+
+    //Back-number via a reused buffer, no allocation per solution
+    back_number_solution_from_inter_to_outer(model, model_tmp);
+    model.swap(model_tmp);
     if (conf.need_decisions_reaching) {
         map_inter_to_outer(decisions_reaching_model);
     }
@@ -1113,7 +1124,10 @@ void Solver::extend_solution(const bool only_sampling_solution)
     }
 
     //map back without BVA
-    model = map_back_to_without_bva(model);
+    if (get_num_bva_vars() > 0) {
+        map_back_to_without_bva(model, model_tmp);
+        model.swap(model_tmp);
+    }
     if (conf.need_decisions_reaching) {
         decisions_reaching_model_valid = true;
         const vector<uint32_t> my_map = build_outer_to_without_bva_map();
@@ -1141,6 +1155,60 @@ void Solver::extend_solution(const bool only_sampling_solution)
     check_model_for_assumptions();
 }
 
+//Maps the sampling vars, then the assumption vars, through BVA and
+//equivalent literal replacement to internal lits. Fails if any of them is
+//eliminated, as then the full solution extension is needed.
+bool Solver::build_model_projection()
+{
+    model_proj_outside.clear();
+    model_proj_inter.clear();
+    auto add = [&](const uint32_t outside_var) -> bool {
+        const uint32_t outer = map_to_with_bva(outside_var);
+        const Lit repl = varReplacer->get_lit_replaced_with_outer(Lit(outer, false));
+        const uint32_t int_var = map_outer_to_inter(repl.var());
+        if (varData[int_var].removed != Removed::none) {
+            return false;
+        }
+        model_proj_outside.push_back(outside_var);
+        model_proj_inter.push_back(Lit(int_var, repl.sign()));
+        return true;
+    };
+
+    for(const uint32_t var: *conf.sampling_vars) {
+        if (!add(var)) {
+            return false;
+        }
+    }
+    for(const AssumptionPair& lit_pair: assumptions) {
+        const uint32_t var = lit_pair.lit_orig_outside.var();
+        if (var != var_Undef && !add(var)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Only the projected entries of the model are ever set, so the model is
+//cleared once and then only the entries of the previous solution are reset
+void Solver::extend_projected_solution()
+{
+    if (!model_is_projection || model.size() != nVarsOutside()) {
+        model.clear();
+        model.resize(nVarsOutside(), l_Undef);
+        model_proj_set.clear();
+        model_is_projection = true;
+    }
+    for(const uint32_t var: model_proj_set) {
+        model[var] = l_Undef;
+    }
+    model_proj_set = model_proj_outside;
+    for(size_t i = 0; i < model_proj_outside.size(); i++) {
+        model[model_proj_outside[i]] = model_proj_vals[i];
+    }
+
+    check_model_for_assumptions();
+}
+
 void Solver::check_xor_cut_config_sanity() const
 {
     if (conf.xor_var_per_cut < 1) {
@@ -1235,11 +1303,24 @@ lbool Solver::solve_with_assumptions(
     const vector<Lit>* _assumptions,
     const bool only_sampling_solution
 ) {
+    return sample_with_assumptions(_assumptions, only_sampling_solution, 1, NULL);
+}
+
+lbool Solver::sample_with_assumptions(
+    const vector<Lit>* _assumptions
+    , const bool only_sampling_solution
+    , const uint64_t num_samples
+    , std::function<bool(const vector<lbool>& model)> callback
+    , uint64_t* num_samples_done
+) {
+    uint64_t done = 0;
     fresh_solver = false;
-    decisions_reaching_model.clear();
-    decisions_reaching_model_valid = false;
     move_to_outside_assumps(_assumptions);
     set_assumptions();
+    project_model = only_sampling_solution
+        && conf.sampling_vars != NULL
+        && !conf.need_decisions_reaching;
+    model_proj_valid = false;
     #ifdef SLOW_DEBUG
     if (ok) {
         assert(check_order_heap_sanity());
@@ -1249,57 +1330,87 @@ lbool Solver::solve_with_assumptions(
     }
     #endif
 
-    solveStats.num_solve_calls++;
     check_config_parameters();
-    luby_loop_num = 0;
-
-    //Reset parameters
-    max_confl_phase = conf.restart_first;
-    max_confl_this_phase = max_confl_phase;
-    var_decay_vsids = conf.var_decay_vsids_start;
-    step_size = conf.orig_step_size;
-    conf.global_timeout_multiplier = conf.orig_global_timeout_multiplier;
-    solveStats.num_simplify_this_solve_call = 0;
-    params.rest_type = conf.restartType;
     if (conf.verbosity >= 6) {
         cout << "c " << __func__ << " called" << endl;
     }
 
-    //Check if adding the clauses caused UNSAT
     lbool status = l_Undef;
-    if (!ok) {
-        assert(conflict.empty());
-        status = l_False;
-        if (conf.verbosity >= 6) {
-            cout << "c Solver status " << status << " on startup of solve()" << endl;
+    do {
+        decisions_reaching_model.clear();
+        decisions_reaching_model_valid = false;
+        solveStats.num_solve_calls++;
+
+        //Reset restart schedule, decay and step size as every solve() call
+        //does, so the samples are the same as from repeated solve() calls.
+        //Only when continuing the previous sample's search are they kept
+        resume_search = conf.sample_continue && done > 0;
+        keep_trail_on_sat = conf.sample_continue && done+1 < num_samples;
+        if (!resume_search) {
+            luby_loop_num = 0;
+            max_confl_phase = conf.restart_first;
+            max_confl_this_phase = max_confl_phase;
+            var_decay_vsids = conf.var_decay_vsids_start;
+            step_size = conf.orig_step_size;
+        }
+        conf.global_timeout_multiplier = conf.orig_global_timeout_multiplier;
+        solveStats.num_simplify_this_solve_call = 0;
+        params.rest_type = conf.restartType;
+
+        //Check if adding the clauses (or last simplification) caused UNSAT
+        status = l_Undef;
+        if (!ok) {
+            assert(conflict.empty());
+            status = l_False;
+            if (conf.verbosity >= 6) {
+                cout << "c Solver status " << status << " on startup of solve()" << endl;
+            }
+            break;
         }
-        goto end;
-    }
-    assert(prop_at_head());
-    assert(okay());
+        assert(prop_at_head());
+        assert(okay());
 
-    //If still unknown, simplify
-    if (status == l_Undef
-        && nVars() > 0
-        && conf.do_simplify_problem
-        && conf.simplify_at_startup
-        && (solveStats.num_simplify == 0 || conf.simplify_at_every_startup)
-    ) {
-        status = simplify_problem(!conf.full_simplify_at_startup);
-    }
+        //If still unknown, simplify -- only once per batch
+        if (done == 0
+            && nVars() > 0
+            && conf.do_simplify_problem
+            && conf.simplify_at_startup
+            && (solveStats.num_simplify == 0 || conf.simplify_at_every_startup)
+        ) {
+            status = simplify_problem(!conf.full_simplify_at_startup);
+        }
 
-    if (status == l_Undef) {
-        status = iterate_until_solved();
-    }
+        if (status == l_Undef) {
+            status = iterate_until_solved();
+        }
+        if (status != l_True) {
+            break;
+        }
 
-    end:
+        handle_found_solution(status, only_sampling_solution);
+        done++;
+        if (callback && !callback(get_model())) {
+            break;
+        }
+    } while(done < num_samples);
 
-    handle_found_solution(status, only_sampling_solution);
+    //l_True has already been handled in the loop
+    keep_trail_on_sat = false;
+    resume_search = false;
+    if (status != l_True) {
+        handle_found_solution(status, only_sampling_solution);
+    }
+    cancelUntil(0);
     unfill_assumptions_set();
     assumptions.clear();
+    project_model = false;
+    model_proj = NULL;
     conf.max_confl = std::numeric_limits<long>::max();
     conf.maxTime = std::numeric_limits<double>::max();
     drat->flush();
+    if (num_samples_done) {
+        *num_samples_done = done;
+    }
     return status;
 }
 
@@ -1338,6 +1449,11 @@ lbool Solver::iterate_until_solved()
         if (num_confl <= 0) {
             break;
         }
+        //Inprocessing may have renumbered or replaced vars since last time
+        if (project_model && !model_proj_valid) {
+            model_proj = build_model_projection() ? &model_proj_inter : NULL;
+            model_proj_valid = true;
+        }
         status = Searcher::solve(num_confl);
 
         //Check for effectiveness
@@ -1395,8 +1511,13 @@ void Solver::check_too_many_low_glues()
 void Solver::handle_found_solution(const lbool status, const bool only_sampling_solution)
 {
     if (status == l_True) {
+        const auto start = std::chrono::steady_clock::now();
         extend_solution(only_sampling_solution);
-        cancelUntil(0);
+        solveStats.extend_time += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        if (!keep_trail_on_sat) {
+            cancelUntil(0);
+        }
 
         #ifdef DEBUG_ATTACH_MORE
         find_all_attach();
@@ -1608,6 +1729,7 @@ lbool Solver::simplify_problem(const bool startup)
     #ifdef USE_GAUSS
     clear_gauss_matrices();
     #endif
+    model_proj_valid = false;
 
     if (conf.verbosity >= 6) {
         cout
@@ -2041,6 +2163,8 @@ uint64_t Solver::mem_used_vardata() const
     uint64_t mem = 0;
     mem += assigns.capacity()*sizeof(lbool);
     mem += varData.capacity()*sizeof(VarData);
+    mem += polar_weight.capacity()*sizeof(double);
+    mem += polar_threshold.capacity()*sizeof(uint32_t);
 
     return mem;
 }
@@ -2058,6 +2182,23 @@ void Solver::print_mem_stats() const
     account += print_mem_used_longclauses(rss_mem_used);
     account += print_watch_mem_used(rss_mem_used);
 
+    if (conf.huge_pages != HugePages::none) {
+        //Process-wide, includes all threads' solvers
+        uint64_t thp_bytes;
+        uint64_t explicit_bytes;
+        huge_pages_in_use(thp_bytes, explicit_bytes);
+        print_stats_line("c Mem on THP huge pages"
+            , thp_bytes/(1024UL*1024UL)
+            , "MB"
+            , stats_line_percent(thp_bytes, rss_mem_used)
+            , "%"
+        );
+        print_stats_line("c Mem on hugetlb pages"
+            , explicit_bytes/(1024UL*1024UL)
+            , "MB"
+        );
+    }
+
     size_t mem = 0;
     mem += mem_used_vardata();
     print_stats_line("c Mem for assings&vardata"
@@ -2589,6 +2730,136 @@ bool Solver::add_clause_outer(const vector<Lit>& lits, bool red)
     return addClauseInt(back_number_from_outside_to_outer_tmp, red);
 }
 
+/**
+@brief Adds irredundant clauses, clause i is lits[offsets[i]] .. lits[offsets[i+1]-1]
+
+The result is the same as calling add_clause_outer() on each clause in turn.
+Before the first solve() the clauses need no renumbering, so they are checked
+all at once and attached in one go, see add_clauses_bulk()
+*/
+bool Solver::add_clauses_outer(
+    const vector<Lit>& lits
+    , const vector<size_t>& offsets
+) {
+    if (!ok) {
+        return false;
+    }
+    if (offsets.size() < 2) {
+        return true;
+    }
+    assert(offsets.back() <= lits.size());
+
+    if (!fresh_solver
+        || get_num_bva_vars() > 0
+        || drat->enabled()
+        || conf.simulate_drat
+    ) {
+        for(size_t i = 0; i+1 < offsets.size() && ok; i++) {
+            bulk_tmp.assign(lits.begin() + offsets[i], lits.begin() + offsets[i+1]);
+            add_clause_outer(bulk_tmp);
+        }
+        return ok;
+    }
+
+    return add_clauses_bulk(lits, offsets);
+}
+
+bool Solver::add_clauses_bulk(
+    const vector<Lit>& lits
+    , const vector<size_t>& offsets
+) {
+    if (conf.perform_occur_based_simp && occsimplifier->getAnythingHasBeenBlocked()) {
+        std::cerr
+        << "ERROR: Cannot add new clauses to the system if blocking was"
+        << " enabled. Turn it off from conf.doBlockClauses"
+        << endl;
+        std::exit(-1);
+    }
+    assert(decisionLevel() == 0);
+    assert(qhead == trail.size());
+    const size_t origTrailSize = trail.size();
+
+    for(size_t i = offsets.front(); i < offsets.back(); i++) {
+        if (lits[i].var() >= nVarsOuter()) {
+            std::cerr
+            << "ERROR: Variable " << lits[i].var() + 1
+            << " inserted, but max var is "
+            << nVarsOuter()
+            << endl;
+            assert(false);
+            std::exit(-1);
+        }
+    }
+
+    //Attachment is deferred. Units propagate over all clauses before them,
+    //so the ones waiting are attached first
+    vector<Lit>& ps = bulk_tmp;
+    assert(bulk_cls.empty());
+    for(size_t i = 0; i+1 < offsets.size(); i++) {
+        if (offsets[i+1] - offsets[i] > (0x01UL << 28)) {
+            cout << "Too long clause!" << endl;
+            throw CMSGen::TooLongClauseError();
+        }
+        ps.assign(lits.begin() + offsets[i], lits.begin() + offsets[i+1]);
+        if (!sort_and_clean_clause(ps, ps, false)) {
+            continue;
+        }
+
+        BulkCl bcl;
+        bcl.bin = ps.size() == 2;
+        switch(ps.size()) {
+            case 0:
+                attach_bulk_clauses();
+                ok = false;
+                if (conf.verbosity >= 6) {
+                    cout
+                    << "c solver received clause through add_clauses(): "
+                    << i << "-th clause of the batch"
+                    << " that became an empty clause at toplevel --> UNSAT"
+                    << endl;
+                }
+                break;
+            case 1:
+                attach_bulk_clauses();
+                enqueue(ps[0]);
+                ok = propagate<true>().isNULL();
+                break;
+            case 2:
+                bcl.lit1 = ps[0];
+                bcl.lit2 = ps[1];
+                bulk_cls.push_back(bcl);
+                break;
+            default:
+                Clause* c = cl_alloc.Clause_new(ps, sumConflicts, ClRegion::irred);
+                cl_alloc.stats(c) = ClauseStats();
+                bcl.offset = cl_alloc.get_offset(c);
+                bulk_cls.push_back(bcl);
+                break;
+        }
+        if (!ok) {
+            break;
+        }
+    }
+    attach_bulk_clauses();
+    zeroLevAssignsByCNF += trail.size() - origTrailSize;
+
+    return ok;
+}
+
+void Solver::attach_bulk_clauses()
+{
+    //Same order as one-by-one, so the watchlists are the same
+    for(const BulkCl& bcl: bulk_cls) {
+        if (bcl.bin) {
+            attach_bin_clause(bcl.lit1, bcl.lit2, false);
+        } else {
+            attachClause(*cl_alloc.ptr(bcl.offset));
+            longIrredCls.push_back(bcl.offset);
+        }
+    }
+    bulk_cls.clear();
+}
+
 bool Solver::add_xor_clause_outer(const vector<uint32_t>& vars, bool rhs)
 {
     if (!ok) {
@@ -2746,6 +3017,248 @@ uint32_t Solver::num_active_vars() const
     return numActive;
 }
 
+static const uint32_t snapshot_magic = 0x534d4353; //"CSMS"
+static const uint32_t snapshot_version = 3;
+
+void Solver::save_snapshot(
+    const string& fname
+    , const uint64_t input_size
+    , const uint64_t input_hash
+) {
+    assert(decisionLevel() == 0);
+    fresh_solver = false;
+
+    //Same startup simplification as the first solve() would do
+    if (ok
+        && nVars() > 0
+        && conf.do_simplify_problem
+        && conf.simplify_at_startup
+        && solveStats.num_simplify == 0
+    ) {
+        move_to_outside_assumps(NULL);
+        set_assumptions();
+        check_config_parameters();
+        simplify_problem(!conf.full_simplify_at_startup);
+        unfill_assumptions_set();
+        assumptions.clear();
+        if (decisionLevel() > 0) {
+            cancelUntil(0);
+        }
+    }
+
+    SimpleOutFile f;
+    f.start(fname);
+    f.put_uint32_t(snapshot_magic);
+    f.put_uint32_t(snapshot_version);
+    f.put_uint64_t(input_size);
+    f.put_uint64_t(input_hash);
+    f.put_uint32_t(ok);
+    if (!ok) {
+        return;
+    }
+
+    f.put_uint32_t(nVarsOuter());
+    CNF::save_snapshot_vars(f);
+    f.put_uint32_t(solveStats.num_simplify);
+
+    vector<uint32_t> must_set;
+    for(uint32_t var = 0; var < undef_must_set_vars.size(); var++) {
+        if (undef_must_set_vars[var]) {
+            must_set.push_back(var);
+        }
+    }
+    f.put_vector(must_set);
+
+    //Irredundant clauses, outer numbering
+    vector<Lit> lits;
+    for(uint32_t i = 0; i < nVars()*2; i++) {
+        const Lit lit = Lit::toLit(i);
+        for(const Watched& w: watches[lit]) {
+            if (w.isBin() && !w.red() && lit < w.lit2()) {
+                lits.push_back(map_inter_to_outer(lit));
+                lits.push_back(map_inter_to_outer(w.lit2()));
+            }
+        }
+    }
+    f.put_vector(lits);
+
+    uint64_t num_long = 0;
+    for(const ClOffset offs: longIrredCls) {
+        num_long += !cl_alloc.ptr(offs)->getRemoved();
+    }
+    f.put_uint64_t(num_long);
+    for(const ClOffset offs: longIrredCls) {
+        const Clause& cl = *cl_alloc.ptr(offs);
+        if (cl.getRemoved()) {
+            continue;
+        }
+        lits.clear();
+        for(const Lit lit: cl) {
+            lits.push_back(map_inter_to_outer(lit));
+        }
+        f.put_uint32_t(cl.used_in_xor());
+        f.put_vector(lits);
+    }
+
+    f.put_uint64_t(xorclauses.size());
+    for(const Xor& x: xorclauses) {
+        vector<uint32_t> vars(x.get_vars());
+        for(uint32_t& var: vars) {
+            var = map_inter_to_outer(var);
+        }
+        f.put_uint32_t(x.rhs);
+        f.put_vector(vars);
+    }
+
+    varReplacer->save_state(f);
+    f.put_uint32_t(occsimplifier != NULL);
+    if (occsimplifier) {
+        occsimplifier->save_state(f);
+    }
+
+    f.put_uint32_t(conf.sampling_vars != NULL);
+    if (conf.sampling_vars) {
+        f.put_vector(*conf.sampling_vars);
+    }
+
+    f.put_uint32_t(order_heap_rand.weights != NULL);
+    if (order_heap_rand.weights) {
+        vector<double> weights(nVarsOuter(), 1.0);
+        for(uint32_t var = 0; var < nVars(); var++) {
+            weights[map_inter_to_outer(var)] = var_branch_weight[var];
+        }
+        f.put_vector(weights);
+    }
+}
+
+bool Solver::load_snapshot(const string& fname)
+{
+    if (nVarsOuter() > 0) {
+        std::cerr << "ERROR: A snapshot can only be loaded into an empty solver" << endl;
+        std::exit(-1);
+    }
+
+    SimpleInFile f;
+    f.start(fname);
+    if (f.get_uint32_t() != snapshot_magic) {
+        std::cerr << "ERROR: File '" << fname << "' is not a snapshot" << endl;
+        std::exit(-1);
+    }
+    const uint32_t version = f.get_uint32_t();
+    if (version != snapshot_version) {
+        std::cerr << "ERROR: Snapshot '" << fname << "' has version " << version
+        << " but this solver only reads version " << snapshot_version << endl;
+        std::exit(-1);
+    }
+    f.get_uint64_t(); //input size
+    f.get_uint64_t(); //input hash
+    fresh_solver = false;
+    ok = f.get_uint32_t();
+    if (!ok) {
+        return ok;
+    }
+
+    //Inter == outer from here on
+    new_vars(f.get_uint32_t());
+    vector<Lit> units;
+    CNF::load_snapshot_vars(f, units);
+    solveStats.num_simplify = f.get_uint32_t();
+
+    vector<uint32_t> must_set;
+    f.get_vector(must_set);
+    for(const uint32_t var: must_set) {
+        if (undef_must_set_vars.size() < var+1) {
+            undef_must_set_vars.resize(var+1, false);
+        }
+        undef_must_set_vars[var] = true;
+    }
+
+    for(const Lit lit: units) {
+        enqueue(lit);
+    }
+    ok = propagate<true>().isNULL();
+
+    vector<Lit> lits;
+    f.get_vector(lits);
+    vector<Lit> cl(2);
+    for(size_t i = 0; i < lits.size() && ok; i += 2) {
+        cl[0] = lits[i];
+        cl[1] = lits[i+1];
+        add_clause_int(cl, false, ClauseStats(), true, NULL, false);
+    }
+
+    const uint64_t num_long = f.get_uint64_t();
+    for(uint64_t i = 0; i < num_long && ok; i++) {
+        const bool used_in_xor = f.get_uint32_t();
+        lits.clear();
+        f.get_vector(lits);
+        Clause* c = add_clause_int(lits, false, ClauseStats(), true, NULL, false);
+        if (c) {
+            c->set_used_in_xor(used_in_xor);
+            longIrredCls.push_back(cl_alloc.get_offset(c));
+        }
+    }
+    if (!ok) {
+        return ok;
+    }
+
+    const uint64_t num_xors = f.get_uint64_t();
+    for(uint64_t i = 0; i < num_xors; i++) {
+        const bool rhs = f.get_uint32_t();
+        vector<uint32_t> vars;
+        f.get_vector(vars);
+        xorclauses.push_back(Xor(vars, rhs));
+        xor_clauses_updated = true;
+    }
+
+    varReplacer->load_state(f);
+    const bool has_occ = f.get_uint32_t();
+    if (has_occ != (occsimplifier != NULL)) {
+        std::cerr << "ERROR: Snapshot '" << fname << "' was saved with"
+        << (has_occ ? "" : "out") << " occurrence-based simplification"
+        << " but the solver is configured differently" << endl;
+        std::exit(-1);
+    }
+    if (occsimplifier) {
+        occsimplifier->load_state(f);
+    }
+
+    if (f.get_uint32_t()) {
+        f.get_vector(snapshot_sampling_vars);
+        conf.sampling_vars = &snapshot_sampling_vars;
+    }
+
+    if (f.get_uint32_t()) {
+        var_branch_weight.clear();
+        f.get_vector(var_branch_weight);
+        order_heap_rand.set_weights(&var_branch_weight);
+    }
+
+    rebuildOrderHeap();
+    return ok;
+}
+
+bool Solver::get_snapshot_input(
+    const string& fname
+    , uint64_t& input_size
+    , uint64_t& input_hash
+) {
+    SimpleInFile f;
+    f.start(fname);
+    try {
+        if (f.get_uint32_t() != snapshot_magic
+            || f.get_uint32_t() != snapshot_version
+        ) {
+            return false;
+        }
+        input_size = f.get_uint64_t();
+        input_hash = f.get_uint64_t();
+    } catch (const std::ios_base::failure&) {
+        return false;
+    }
+    return true;
+}
+
 lbool Solver::load_solution_from_file(const string& fname)
 {
     //At this point, model is set up, we just need to fill the l_Undef in
@@ -2828,6 +3341,7 @@ lbool Solver::load_solution_from_file(const string& fname)
 template<typename A>
 void Solver::parse_v_line(A* in, const size_t lineNum)
 {
+    model_is_projection = false;
     model.resize(nVarsOuter(), l_Undef);
 
     int32_t parsed_lit;
@@ -3121,7 +3635,7 @@ bool Solver::get_next_small_clause(vector<Lit>& out)
         const ClOffset offs = longRedCls[0][learnt_clause_query_at];
         const Clause* cl = cl_alloc.ptr(offs);
         if (cl->size() <= learnt_clause_query_max_len
-            && cl->stats.glue <= learnt_clause_query_max_glue
+            && cl_alloc.stats(cl).glue <= learnt_clause_query_max_glue
         ) {
             out = clause_outer_numbered(*cl);
             if (all_vars_outside(out)) {
@@ -3229,5 +3743,33 @@ const Lit lit, const double weight
             << endl;
         exit(-1);
     }
-    varData[lit.var()].weight = weight;
+    polar_weight[lit.var()] = weight;
+    polar_threshold[lit.var()] = polar_weight_to_threshold(weight);
+}
+
+void Solver::set_var_branch_weight(const uint32_t var, const double weight)
+{
+    if (!(weight > 0.0)) {
+        cout << "ERROR: Branching weight must be larger than 0."
+            << " You gave weight '" << weight << "' to variable: " << var+1
+            << endl;
+        exit(-1);
+    }
+    if (var >= nVarsOutside()) {
+        cout << "ERROR: Branching weight given to variable " << var+1
+            << " but there are only " << nVarsOutside() << " variables" << endl;
+        exit(-1);
+    }
+    const uint32_t int_var = map_outer_to_inter(map_to_with_bva(var));
+
+    //Weight must not change while the var is inside the order heap
+    const bool inside = order_heap_rand.inHeap(int_var);
+    order_heap_rand.remove(int_var);
+    var_branch_weight[int_var] = weight;
+    if (order_heap_rand.weights == NULL) {
+        order_heap_rand.set_weights(&var_branch_weight);
+    }
+    if (inside) {
+        order_heap_rand.insert(int_var);
+    }
 }
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include <iostream>
 #include <utility>
 #include <string>
+#include <functional>
 
 #include "constants.h"
 #include "solvertypes.h"
@@ -37,6 +38,7 @@ THE SOFTWARE.
 #include "searcher.h"
 #include "clauseusagestats.h"
 #include "searchstats.h"
+#include "workerpool.h"
 #ifdef CMS_TESTING_ENABLED
 #include "gtest/gtest_prod.h"
 #endif
@@ -71,6 +73,7 @@ struct SolveStats
     uint32_t num_simplify = 0;
     uint32_t num_simplify_this_solve_call = 0;
     uint32_t num_solve_calls = 0;
+    double extend_time = 0; //wall-clock, a sample can take microseconds
 };
 
 class Solver : public Searcher
@@ -82,10 +85,25 @@ class Solver : public Searcher
         void new_external_var();
         void new_external_vars(size_t n);
         bool add_clause_outer(const vector<Lit>& lits, bool red = false);
+        bool add_clauses_outer(const vector<Lit>& lits, const vector<size_t>& offsets);
         bool add_xor_clause_outer(const vector<uint32_t>& vars, bool rhs);
         void set_var_weight(Lit lit, double weight);
+        void set_var_branch_weight(uint32_t var, double weight);
 
         lbool solve_with_assumptions(const vector<Lit>* _assumptions, bool only_indep_solution);
+
+        //Draws up to num_samples solutions without tearing down the search
+        //state in-between. Setup (assumptions, parameter resets, startup
+        //simplification) is done once. Callback gets the model (outside
+        //numbering) and returns false to stop early. Returns status of the
+        //last solve. num_samples_done is set to the number of callbacks made.
+        lbool sample_with_assumptions(
+            const vector<Lit>* _assumptions
+            , bool only_indep_solution
+            , uint64_t num_samples
+            , std::function<bool(const vector<lbool>& model)> callback
+            , uint64_t* num_samples_done = NULL
+        );
         lbool simplify_with_assumptions(const vector<Lit>* _assumptions = NULL);
 
         //drat for SAT problems
@@ -97,6 +115,7 @@ class Solver : public Searcher
         lbool full_model_value (const Lit p) const;  ///<Found model value for lit
         lbool full_model_value (const uint32_t p) const;  ///<Found model value for var
         const vector<lbool>& get_model() const;
+        double get_extend_time() const { return solveStats.extend_time; }
         const vector<Lit>& get_decisions_reaching_model() const;
         const vector<Lit>& get_final_conflict() const;
         vector<pair<Lit, Lit> > get_all_binary_xors() const;
@@ -157,6 +176,7 @@ class Solver : public Searcher
         DistillerLong*         distill_long_cls = NULL;
         DistillerLongWithImpl* dist_long_with_impl = NULL;
         StrImplWImplStamp* dist_impl_with_impl = NULL;
+        WorkerPool             simp_workers; ///<Threads of the batched simplification passes
 
         SearchStats sumSearchStats;
         PropStats sumPropStats;
@@ -172,6 +192,21 @@ class Solver : public Searcher
         void parse_v_line(A* in, const size_t lineNum);
         lbool load_solution_from_file(const string& fname);
 
+        //Snapshot of the problem after startup simplification: clauses,
+        //var maps, eliminated clauses and replaced vars. Loading it into a
+        //fresh solver is equivalent to re-adding the CNF and simplifying it.
+        //The size and hash of the input it was made from are stored in the
+        //header, so callers can tell a stale snapshot from a current one
+        void save_snapshot(
+            const string& fname
+            , uint64_t input_size = 0
+            , uint64_t input_hash = 0);
+        bool load_snapshot(const string& fname);
+        static bool get_snapshot_input(
+            const string& fname
+            , uint64_t& input_size
+            , uint64_t& input_hash);
+
         uint64_t getNumLongClauses() const;
         bool addClause(const vector<Lit>& ps, const bool red = false);
         bool add_xor_clause_inter(
@@ -310,6 +345,7 @@ class Solver : public Searcher
         }
         void check_switchoff_limits_newvar(size_t n = 1);
         vector<Lit> outside_assumptions;
+        vector<uint32_t> snapshot_sampling_vars;
 
         //Stats printing
         void print_norm_stats(const double cpu_time, const double cpu_time_total) const;
@@ -322,6 +358,19 @@ class Solver : public Searcher
         void check_minimization_effectiveness(lbool status);
         void check_recursive_minimization_effectiveness(const lbool status);
         void extend_solution(const bool only_indep_solution);
+        vector<lbool> model_tmp;
+
+        //Sampling-only solutions are read straight off the internal vars
+        //the sampling (and assumption) vars map to. The mapping is built
+        //once per batch of samples, and again only if simplification ran
+        bool project_model = false;
+        bool model_proj_valid = false;
+        bool model_is_projection = false;
+        vector<uint32_t> model_proj_outside;
+        vector<Lit> model_proj_inter;
+        vector<uint32_t> model_proj_set;
+        bool build_model_projection();
+        void extend_projected_solution();
         void check_too_many_low_glues();
         bool adjusted_glue_cutoff_if_too_many = false;
 
@@ -372,6 +421,18 @@ class Solver : public Searcher
         bool addClauseHelper(vector<Lit>& ps);
         bool addClauseInt(vector<Lit>& ps, const bool red = false);
 
+        //Irredundant clauses added by add_clauses_outer(), not yet attached
+        struct BulkCl {
+            bool bin;
+            Lit lit1; ///<Binaries only
+            Lit lit2; ///<Binaries only
+            ClOffset offset; ///<Long clauses only
+        };
+        bool add_clauses_bulk(const vector<Lit>& lits, const vector<size_t>& offsets);
+        void attach_bulk_clauses();
+        vector<BulkCl> bulk_cls;
+        vector<Lit> bulk_tmp;
+
 
         /////////////////
         // Debug
@@ -119,11 +119,13 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , velim_resolvent_too_large(20)
         , var_linkin_limit_MB(1000)
         , min_bva_gain(2)
+        , bve_threads(1)
 
         //Subs, str limits for simplifier
         , subsumption_time_limitM(300)
         , strengthening_time_limitM(300)
         , aggressive_elim_time_limitM(300)
+        , subsume_threads(1)
 
 
         //Ternary resolution
@@ -153,6 +155,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , maxXorToFind     (7)
         , maxXorToFindSlow (5)
         , useCacheWhenFindingXors(false)
+        , xor_find_threads(1)
         , maxXORMatrix     (400ULL)
         #ifndef USE_GAUSS
         , xor_finder_time_limitM(50)
@@ -258,6 +261,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //Sampling
         , sampling_vars(NULL)
+        , sample_continue(false)
 
         //Timeouts
         , orig_global_timeout_multiplier(4.0)
@@ -268,6 +272,8 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //misc
         , origSeed(0)
+        , rand_gen(RandGenType::xoshiro)
+        , huge_pages(HugePages::none)
         , sync_every_confl(20000)
         , simulate_drat(false)
         , need_decisions_reaching(false)
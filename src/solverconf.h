@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include <cassert>
 #include "constants.h"
 #include "solvertypesmini.h"
+#include "hugealloc.h"
 
 using std::string;
 
@@ -53,7 +54,10 @@ inline unsigned clean_to_int(ClauseClean t)
     assert(false);
 }
 
-enum class PolarityMode { polarmode_weighted };
+enum class PolarityMode {
+    polarmode_weighted_fixed ///<32-bit thresholds, two decisions per RNG draw
+    , polarmode_weighted ///<Double compare, as in earlier versions
+};
 enum class Restart { fixed };
 
 inline std::string getNameOfRestartType(Restart rest_type)
@@ -227,11 +231,13 @@ class DLL_PUBLIC SolverConf
         int velim_resolvent_too_large; //-1 == no limit
         int var_linkin_limit_MB;
         int min_bva_gain;
+        unsigned bve_threads; ///<Threads to compute resolvents with, 1 = serial
 
         //Subs, str limits for simplifier
         long long subsumption_time_limitM;
         long long strengthening_time_limitM;
         long long aggressive_elim_time_limitM;
+        unsigned subsume_threads; ///<Threads to find long subsumed/strengthened clauses with, 1 = serial
 
         //Ternary resolution
         bool doTernary;
@@ -260,6 +266,7 @@ class DLL_PUBLIC SolverConf
         unsigned maxXorToFind;
         unsigned maxXorToFindSlow;
         int      useCacheWhenFindingXors;
+        unsigned xor_find_threads; ///<Threads to recover XORs from clauses with, 1 = serial
         uint64_t maxXORMatrix;
         uint64_t xor_finder_time_limitM;
         int      allow_elim_xor_vars;
@@ -326,6 +333,7 @@ class DLL_PUBLIC SolverConf
 
         //Sampling
         std::vector<uint32_t>* sampling_vars;
+        int      sample_continue; ///<Between samples, only backtrack to a random level. Biases the samples
 
         //Timeouts
         double orig_global_timeout_multiplier;
@@ -336,6 +344,8 @@ class DLL_PUBLIC SolverConf
 
         //Misc
         unsigned origSeed;
+        RandGenType rand_gen;
+        HugePages huge_pages; ///<Backing of the clause arena and watch array
         unsigned long long sync_every_confl;
         int      need_decisions_reaching;
         int      simulate_drat = false;
@@ -64,6 +64,13 @@ struct CH {
     }
 };
 
+//The number "head.tail" as parseDouble() reads it
+inline double dimacs_double(const int32_t head, const int64_t tail)
+{
+    uint32_t num_10s = std::floor(std::log10(tail));
+    return head + tail/std::pow(10, num_10s+1);
+}
+
 template<typename A, typename B>
 class StreamBuffer
 {
@@ -167,8 +174,7 @@ public:
             if (!rc) {
                 return false;
             }
-            uint32_t num_10s = std::floor(std::log10(tail));
-            ret = head + tail/std::pow(10, num_10s+1);
+            ret = dimacs_double(head, tail);
         } else {
             ret = head;
         }
@@ -59,6 +59,11 @@ uint32_t SubsumeStrengthen::subsume_and_unlink_and_markirred(const ClOffset offs
         , cl.abst
     );
 
+    return finish_subsume(cl, ret);
+}
+
+uint32_t SubsumeStrengthen::finish_subsume(Clause& cl, const Sub0Ret& ret)
+{
     //If irred is subsumed by redundant, make the redundant into irred
     if (cl.red()
         && ret.subsumedIrred
@@ -76,7 +81,8 @@ uint32_t SubsumeStrengthen::subsume_and_unlink_and_markirred(const ClOffset offs
     }
 
     //Combine stats
-    cl.combineStats(ret.stats);
+    ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
+    cl_stats = ClauseStats::combineStats(cl_stats, ret.stats);
 
     return ret.numSubsumed;
 }
@@ -97,15 +103,25 @@ SubsumeStrengthen::Sub0Ret SubsumeStrengthen::subsume_and_unlink(
     , const cl_abst_type abs
     , const bool removeImplicit
 ) {
-    Sub0Ret ret;
-
     subs.clear();
     find_subsumed(offset, ps, abs, subs, removeImplicit);
 
+    return unlink_subsumed(subs);
+}
+
+SubsumeStrengthen::Sub0Ret SubsumeStrengthen::unlink_subsumed(
+    const vector<ClOffset>& subsumed
+) {
+    Sub0Ret ret;
+
     //Go through each clause that can be subsumed
-    for (const ClOffset offs: subs) {
+    for (const ClOffset offs: subsumed) {
         Clause *tmp = solver->cl_alloc.ptr(offs);
-        ret.stats = ClauseStats::combineStats(tmp->stats, ret.stats);
+        //Removed since found, by an earlier clause of the same batch
+        if (tmp->getRemoved())
+            continue;
+
+        ret.stats = ClauseStats::combineStats(solver->cl_alloc.stats(tmp), ret.stats);
         #ifdef VERBOSE_DEBUG
         cout << "-> subsume removing:" << *tmp << endl;
         #endif
@@ -129,7 +145,6 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
 {
     subs.clear();
     subsLits.clear();
-    Sub1Ret ret;
     Clause& cl = *solver->cl_alloc.ptr(offset);
     assert(!cl.getRemoved());
     assert(!cl.freed());
@@ -143,13 +158,32 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
         , cl.abst
         , subs
         , subsLits
+        , simplifier->limit_to_decrease
     );
 
+    return strengthen_or_subsume(offset, subs, subsLits, false);
+}
+
+/**
+@brief Applies what findStrengthened() found for the clause at "offset"
+
+@param recheck The clauses may have changed since they were found, so
+subsumption or strengthening must be checked again. The time of the check is
+not charged again, the caller already charged what finding them took
+*/
+SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_or_subsume(
+    const ClOffset offset
+    , const vector<ClOffset>& subsumed
+    , const vector<Lit>& lits
+    , const bool recheck
+) {
+    Sub1Ret ret;
+    Clause& cl = *solver->cl_alloc.ptr(offset);
     for (size_t j = 0
-        ; j < subs.size() && solver->okay()
+        ; j < subsumed.size() && solver->okay()
         ; j++
     ) {
-        ClOffset offset2 = subs[j];
+        ClOffset offset2 = subsumed[j];
         Clause& cl2 = *solver->cl_alloc.ptr(offset2);
         #ifdef USE_GAUSS
         if (cl2.used_in_xor()) {
@@ -157,7 +191,21 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
         }
         #endif
 
-        if (subsLits[j] == lit_Undef) {  //Subsume
+        Lit lit = lits[j];
+        if (recheck) {
+            if (cl2.getRemoved()
+                || cl.size() > cl2.size()
+            ) {
+                continue;
+            }
+            //Its time was charged when it was found
+            int64_t recheck_limit = 0;
+            lit = subset1(cl, cl2, &recheck_limit);
+            if (lit == lit_Error)
+                continue;
+        }
+
+        if (lit == lit_Undef) {  //Subsume
             #ifdef VERBOSE_DEBUG
             if (solver->conf.verbosity >= 6)
                 cout << "subsumed clause " << cl2 << endl;
@@ -180,7 +228,8 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
             }
 
             //Update stats
-            cl.combineStats(cl2.stats);
+            ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
+            cl_stats = ClauseStats::combineStats(cl_stats, solver->cl_alloc.stats(cl2));
 
             simplifier->unlink_clause(offset2, true, false, true);
             ret.sub++;
@@ -195,7 +244,7 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
                 continue;
             }
             #endif
-            remove_literal(offset2, subsLits[j]);
+            remove_literal(offset2, lit);
 
             ret.str++;
             if (!solver->ok)
@@ -226,7 +275,11 @@ void SubsumeStrengthen::backw_sub_long_with_long()
     size_t subsumed = 0;
     const int64_t orig_limit = simplifier->subsumption_time_limit;
     randomise_clauses_order();
-    while (*simplifier->limit_to_decrease > 0
+    if (solver->conf.subsume_threads > 1) {
+        subsumed = backw_sub_long_with_long_batches(wenThrough);
+    }
+    while (solver->conf.subsume_threads == 1
+        && *simplifier->limit_to_decrease > 0
         && (double)wenThrough < solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size()
     ) {
         *simplifier->limit_to_decrease -= 3;
@@ -281,7 +334,11 @@ bool SubsumeStrengthen::backw_str_long_with_long()
     Sub1Ret ret;
 
     randomise_clauses_order();
-    while(*simplifier->limit_to_decrease > 0
+    if (solver->conf.subsume_threads > 1) {
+        ret = backw_str_long_with_long_batches(wenThrough);
+    }
+    while(solver->conf.subsume_threads == 1
+        && *simplifier->limit_to_decrease > 0
         && wenThrough < 1.5*(double)2*simplifier->clauses.size()
         && solver->okay()
     ) {
@@ -331,6 +388,129 @@ bool SubsumeStrengthen::backw_str_long_with_long()
     return solver->okay();
 }
 
+/**
+@brief Picks the next clauses to check, the same way the serial loops do
+
+The clauses are taken round-robin from the shuffled clause list, and the same
+time is charged for them as in the serial loops.
+@return The number of clauses picked into "batch"
+*/
+size_t SubsumeStrengthen::fill_batch(
+    size_t& wenThrough
+    , const double max_through
+    , const int64_t cost_tried
+    , const int64_t cost_not_removed
+) {
+    const size_t max_batch = 4096;
+    size_t batch_size = 0;
+    while (batch_size < max_batch
+        && *simplifier->limit_to_decrease > 0
+        && (double)wenThrough < max_through
+    ) {
+        *simplifier->limit_to_decrease -= cost_tried;
+        wenThrough++;
+
+        const size_t at = wenThrough % simplifier->clauses.size();
+        const ClOffset offset = simplifier->clauses[at];
+        Clause* cl = solver->cl_alloc.ptr(offset);
+        if (cl->freed() || cl->getRemoved())
+            continue;
+
+        *simplifier->limit_to_decrease -= cost_not_removed;
+        if (batch.size() <= batch_size) {
+            batch.resize(batch_size+1);
+        }
+        batch[batch_size++].offset = offset;
+    }
+
+    return batch_size;
+}
+
+/**
+@brief Finds what each clause of the batch subsumes (or strengthens)
+
+Nothing is changed here, so the clauses are spread over
+conf.subsume_threads threads. The time each clause took is recorded, to be
+charged when its results are applied.
+*/
+void SubsumeStrengthen::check_batch(const size_t batch_size, const bool strengthen)
+{
+    solver->simp_workers.run_strided(solver->conf.subsume_threads, batch_size
+        , [&](const size_t, const size_t i) {
+        Candidate& c = batch[i];
+        const Clause& cl = *solver->cl_alloc.ptr(c.offset);
+        int64_t limit = 0;
+        c.subs.clear();
+        c.subsLits.clear();
+        if (strengthen) {
+            findStrengthened(c.offset, cl, cl.abst, c.subs, c.subsLits, &limit);
+        } else {
+            find_subsumed(c.offset, cl, cl.abst, c.subs, false, &limit);
+        }
+        c.time_used = -limit;
+    });
+}
+
+//Subsumption only removes clauses, so what was found still holds, except
+//when the subsuming clause itself got removed (e.g. duplicates)
+size_t SubsumeStrengthen::backw_sub_long_with_long_batches(size_t& wenThrough)
+{
+    size_t subsumed = 0;
+    const double max_through =
+        solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size();
+    while (*simplifier->limit_to_decrease > 0
+        && (double)wenThrough < max_through
+    ) {
+        const size_t batch_size = fill_batch(wenThrough, max_through, 3, 10);
+        check_batch(batch_size, false);
+        for(size_t i = 0
+            ; i < batch_size && *simplifier->limit_to_decrease > 0
+            ; i++
+        ) {
+            const Candidate& c = batch[i];
+            *simplifier->limit_to_decrease -= c.time_used;
+            Clause& cl = *solver->cl_alloc.ptr(c.offset);
+            if (cl.getRemoved())
+                continue;
+
+            subsumed += finish_subsume(cl, unlink_subsumed(c.subs));
+        }
+    }
+
+    return subsumed;
+}
+
+//Strengthening changes clauses, so everything found is checked again
+//before it's applied
+SubsumeStrengthen::Sub1Ret SubsumeStrengthen::backw_str_long_with_long_batches(
+    size_t& wenThrough
+) {
+    Sub1Ret ret;
+    const double max_through = 1.5*(double)2*simplifier->clauses.size();
+    while (*simplifier->limit_to_decrease > 0
+        && (double)wenThrough < max_through
+        && solver->okay()
+    ) {
+        const size_t batch_size = fill_batch(wenThrough, max_through, 10, 0);
+        check_batch(batch_size, true);
+        for(size_t i = 0
+            ; i < batch_size
+                && *simplifier->limit_to_decrease > 0
+                && solver->okay()
+            ; i++
+        ) {
+            const Candidate& c = batch[i];
+            *simplifier->limit_to_decrease -= c.time_used;
+            if (solver->cl_alloc.ptr(c.offset)->getRemoved())
+                continue;
+
+            ret += strengthen_or_subsume(c.offset, c.subs, c.subsLits, true);
+        }
+    }
+
+    return ret;
+}
+
 /**
 @brief Helper function for findStrengthened
 
@@ -344,10 +524,11 @@ void inline SubsumeStrengthen::fillSubs(
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
     , const Lit lit
+    , int64_t* limit
 ) {
     Lit litSub;
     watch_subarray_const cs = solver->watches[lit];
-    *simplifier->limit_to_decrease -= (long)cs.size()*2+ 40;
+    *limit -= (long)cs.size()*2+ 40;
     for (const Watched *it = cs.begin(), *end = cs.end()
         ; it != end
         ; ++it
@@ -369,8 +550,8 @@ void inline SubsumeStrengthen::fillSubs(
             continue;
         }
 
-        *simplifier->limit_to_decrease -= (long)((cl.size() + cl2.size())/4);
-        litSub = subset1(cl, cl2);
+        *limit -= (long)((cl.size() + cl2.size())/4);
+        litSub = subset1(cl, cl2, limit);
         if (litSub != lit_Error) {
             out_subsumed.push_back(it->get_offset());
             out_lits.push_back(litSub);
@@ -407,6 +588,7 @@ void SubsumeStrengthen::findStrengthened(
     , const cl_abst_type abs
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
+    , int64_t* limit
 )
 {
     #ifdef VERBOSE_DEBUG
@@ -426,10 +608,10 @@ void SubsumeStrengthen::findStrengthened(
         }
     }
     assert(minVar != var_Undef);
-    *simplifier->limit_to_decrease -= (long)cl.size();
+    *limit -= (long)cl.size();
 
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true));
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false));
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true), limit);
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false), limit);
 }
 
 bool SubsumeStrengthen::handle_added_long_cl(
@@ -452,7 +634,7 @@ bool SubsumeStrengthen::handle_added_long_cl(
         if (cl->freed() || cl->getRemoved())
             continue;
 
-        cl->stats.marked_clause = 0;
+        solver->cl_alloc.stats(cl).marked_clause = 0;
         auto ret = strengthen_subsume_and_unlink_and_markirred(offs);
         stat += ret;
         if (!solver->ok) {
@@ -479,7 +661,7 @@ bool SubsumeStrengthen::handle_added_long_cl(
             if (cl->freed() || cl->getRemoved())
                 continue;
 
-            cl->stats.marked_clause = 0;
+            solver->cl_alloc.stats(cl).marked_clause = 0;
         }
     }
 
@@ -548,7 +730,7 @@ bool SubsumeStrengthen::subsetAbst(const cl_abst_type A, const cl_abst_type B)
 
 //A subsumes B (A <= B)
 template<class T1, class T2>
-bool SubsumeStrengthen::subset(const T1& A, const T2& B)
+bool SubsumeStrengthen::subset(const T1& A, const T2& B, int64_t* limit)
 {
     #ifdef MORE_DEUBUG
     cout << "A:" << A << endl;
@@ -589,7 +771,7 @@ bool SubsumeStrengthen::subset(const T1& A, const T2& B)
     ret = false;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    *limit -= (long)i2*4 + (long)i*4;
     return ret;
 }
 
@@ -607,7 +789,7 @@ clause B
 and returns the literal to remove if (2) is true
 */
 template<class T1, class T2>
-Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
+Lit SubsumeStrengthen::subset1(const T1& A, const T2& B, int64_t* limit)
 {
     Lit retLit = lit_Undef;
 
@@ -639,12 +821,12 @@ Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
     retLit = lit_Error;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    *limit -= (long)i2*4 + (long)i*4;
     return retLit;
 }
 
 template<class T>
-size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
+size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps, int64_t* limit) const
 {
     size_t min_i = 0;
     size_t min_num = solver->watches[ps[min_i]].size();
@@ -655,7 +837,7 @@ size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
             min_num = this_num;
         }
     }
-    *simplifier->limit_to_decrease -= (long)ps.size();
+    *limit -= (long)ps.size();
 
     return min_i;
 }
@@ -663,8 +845,10 @@ size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
 /**
 @brief Finds clauses that are backward-subsumed by given clause
 
-Only handles backward-subsumption. Uses occurrence lists
+Only handles backward-subsumption. Uses occurrence lists. Unless
+removeImplicit is set, nothing is changed, so it can run on many threads.
 @param[out] out_subsumed The set of clauses subsumed by the given
+@param limit Time limit to decrease, the simplifier's if NULL
 */
 template<class T> void SubsumeStrengthen::find_subsumed(
     const ClOffset offset //Will not match with index of the name value
@@ -672,7 +856,11 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     , const cl_abst_type abs //Abstraction of literals in clause
     , vector<ClOffset>& out_subsumed //List of clause indexes subsumed
     , bool removeImplicit
+    , int64_t* limit
 ) {
+    if (limit == NULL)
+        limit = simplifier->limit_to_decrease;
+
     #ifdef VERBOSE_DEBUG
     cout << "find_subsumed: ";
     for (const Lit lit: ps) {
@@ -681,11 +869,11 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     cout << endl;
     #endif
 
-    const size_t smallest = find_smallest_watchlist_for_clause(ps);
+    const size_t smallest = find_smallest_watchlist_for_clause(ps, limit);
 
     //Go through the occur list of the literal that has the smallest occur list
     watch_subarray occ = solver->watches[ps[smallest]];
-    *simplifier->limit_to_decrease -= (long)occ.size()*8 + 40;
+    *limit -= (long)occ.size()*8 + 40;
 
     Watched* it = occ.begin();
     Watched* it2 = occ.begin();
@@ -713,14 +901,14 @@ template<class T> void SubsumeStrengthen::find_subsumed(
                     continue;
                 }
             }
+            *it2++ = *it;
         }
-        *it2++ = *it;
 
         if (!it->isClause()) {
             continue;
         }
 
-        *simplifier->limit_to_decrease -= 15;
+        *limit -= 15;
 
         if (it->get_offset() == offset
             || !subsetAbst(abs, it->getAbst())
@@ -734,15 +922,16 @@ template<class T> void SubsumeStrengthen::find_subsumed(
         if (ps.size() > cl2.size() || cl2.getRemoved())
             continue;
 
-        *simplifier->limit_to_decrease -= 50;
-        if (subset(ps, cl2)) {
+        *limit -= 50;
+        if (subset(ps, cl2, limit)) {
             out_subsumed.push_back(offset2);
             #ifdef VERBOSE_DEBUG
             cout << "subsumed cl offset: " << offset2 << endl;
             #endif
         }
     }
-    occ.shrink(it-it2);
+    if (removeImplicit)
+        occ.shrink(it-it2);
 }
 template void SubsumeStrengthen::find_subsumed(
     const ClOffset offset
@@ -750,6 +939,7 @@ template void SubsumeStrengthen::find_subsumed(
     , const cl_abst_type abs //Abstraction of literals in clause
     , vector<ClOffset>& out_subsumed //List of clause indexes subsumed
     , bool removeImplicit
+    , int64_t* limit
 );
 
 size_t SubsumeStrengthen::mem_used() const
@@ -757,6 +947,11 @@ size_t SubsumeStrengthen::mem_used() const
     size_t b = 0;
     b += subs.capacity()*sizeof(ClOffset);
     b += subsLits.capacity()*sizeof(Lit);
+    b += batch.capacity()*sizeof(Candidate);
+    for(const Candidate& c: batch) {
+        b += c.subs.capacity()*sizeof(ClOffset);
+        b += c.subsLits.capacity()*sizeof(Lit);
+    }
 
     return b;
 }
@@ -822,6 +1017,7 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::backw_sub_str_long_with_implicit(
         , calcAbstraction(lits)
         , subs
         , subsLits
+        , simplifier->limit_to_decrease
     );
 
     Sub1Ret ret;
@@ -102,6 +102,7 @@ public:
         , const cl_abst_type abs
         , vector<ClOffset>& out_subsumed
         , const bool removeImplicit = false
+        , int64_t* limit = NULL
     );
 
 private:
@@ -119,12 +120,41 @@ private:
         , const cl_abst_type abs
         , const bool removeImplicit = false
     );
+    Sub0Ret unlink_subsumed(const vector<ClOffset>& subsumed);
+    uint32_t finish_subsume(Clause& cl, const Sub0Ret& ret);
+    Sub1Ret strengthen_or_subsume(
+        const ClOffset offset
+        , const vector<ClOffset>& subsumed
+        , const vector<Lit>& lits
+        , const bool recheck
+    );
+
+    //Multi-threaded backward subsumption and strengthening. A batch of
+    //clauses is checked on worker threads against the unchanging occurrence
+    //lists, then the results are applied in order on the calling thread
+    struct Candidate
+    {
+        ClOffset offset;
+        int64_t time_used;
+        vector<ClOffset> subs;
+        vector<Lit> subsLits; ///<lit_Undef if subsumed, else the lit to remove
+    };
+    vector<Candidate> batch;
+    size_t fill_batch(
+        size_t& wenThrough
+        , const double max_through
+        , const int64_t cost_tried
+        , const int64_t cost_not_removed
+    );
+    void check_batch(const size_t batch_size, const bool strengthen);
+    size_t backw_sub_long_with_long_batches(size_t& wenThrough);
+    Sub1Ret backw_str_long_with_long_batches(size_t& wenThrough);
 
     void randomise_clauses_order();
     void remove_literal(ClOffset c, const Lit toRemoveLit);
 
     template<class T>
-    size_t find_smallest_watchlist_for_clause(const T& ps) const;
+    size_t find_smallest_watchlist_for_clause(const T& ps, int64_t* limit) const;
 
     template<class T>
     void findStrengthened(
@@ -133,6 +163,7 @@ private:
         , const cl_abst_type abs
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
+        , int64_t* limit
     );
 
     template<class T>
@@ -143,13 +174,14 @@ private:
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
         , const Lit lit
+        , int64_t* limit
     );
 
     template<class T1, class T2>
-    bool subset(const T1& A, const T2& B);
+    bool subset(const T1& A, const T2& B, int64_t* limit);
 
     template<class T1, class T2>
-    Lit subset1(const T1& A, const T2& B);
+    Lit subset1(const T1& A, const T2& B, int64_t* limit);
     bool subsetAbst(const cl_abst_type A, const cl_abst_type B);
 
     vector<ClOffset> subs;
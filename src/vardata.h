@@ -30,12 +30,22 @@ THE SOFTWARE.
 namespace CMSGen
 {
 
+/**
+@brief Per-variable data of the search
+
+Conflict analysis and propagation read & write this for every literal they look
+at, so it's kept to 16 bytes. The polarity weight, which is only read when
+picking a polarity, is in CNF::polar_weight.
+*/
 struct VarData
 {
+    VarData() :
+        is_bva(false)
+        , added_for_xor(false)
+    {}
+
     ///contains the decision level at which the assignment was made.
     uint32_t level = 0;
-    double weight = 0.5;
-    uint32_t cancelled = 0;
 
     //Reason this got propagated. NULL means decision/toplevel
     PropBy reason = PropBy();
@@ -45,11 +55,12 @@ struct VarData
     ///Whether var has been eliminated (var-elim, different component, etc.)
     Removed removed = Removed::none;
 
-    ///The preferred polarity of each variable.
+    ///The preferred polarity of each variable. Written at every enqueue
     bool polarity = false;
-    bool is_bva = false;
-    bool added_for_xor = false;
+    bool is_bva:1;
+    bool added_for_xor:1;
 };
+static_assert(sizeof(VarData) == 16, "VarData is read by conflict analysis, keep it small");
 
 }
 
@@ -94,6 +94,36 @@ void VarReplacer::save_on_var_memory()
 {
 }
 
+void VarReplacer::save_state(SimpleOutFile& f) const
+{
+    f.put_vector(table);
+    f.put_uint64_t(reverseTable.size());
+    for(const auto& it: reverseTable) {
+        f.put_uint32_t(it.first);
+        f.put_vector(it.second);
+    }
+    f.put_uint64_t(replacedVars);
+    f.put_struct(globalStats);
+}
+
+void VarReplacer::load_state(SimpleInFile& f)
+{
+    table.clear();
+    f.get_vector(table);
+    assert(table.size() == solver->nVarsOuter());
+
+    reverseTable.clear();
+    flat_valid = false;
+    const uint64_t sz = f.get_uint64_t();
+    for(uint64_t i = 0; i < sz; i++) {
+        const uint32_t var = f.get_uint32_t();
+        f.get_vector(reverseTable[var]);
+    }
+    replacedVars = f.get_uint64_t();
+    lastReplacedVars = replacedVars;
+    f.get_struct(globalStats);
+}
+
 void VarReplacer::updateVars(
     const std::vector< uint32_t >& /*outerToInter*/
     , const std::vector< uint32_t >& /*interToOuter*/
@@ -646,20 +676,34 @@ void VarReplacer::extend_model(const uint32_t var)
     }
 }
 
+void VarReplacer::build_flat_reverse_table()
+{
+    flat_reps.clear();
+    flat_offs.clear();
+    flat_subs.clear();
+    for(const auto& it: reverseTable) {
+        flat_reps.push_back(it.first);
+        flat_offs.push_back(flat_subs.size());
+        flat_subs.insert(flat_subs.end(), it.second.begin(), it.second.end());
+    }
+    flat_offs.push_back(flat_subs.size());
+    flat_valid = true;
+}
+
 void VarReplacer::extend_model_already_set()
 {
     assert(solver->model.size() == solver->nVarsOuter());
-    for (auto it = reverseTable.begin() , end = reverseTable.end()
-        ; it != end
-        ; ++it
-    ) {
-        if (solver->model_value(it->first) == l_Undef) {
+    if (!flat_valid) {
+        build_flat_reverse_table();
+    }
+    for(size_t i = 0; i < flat_reps.size(); i++) {
+        const uint32_t var = flat_reps[i];
+        if (solver->model_value(var) == l_Undef) {
             continue;
         }
 
-        for(const uint32_t sub_var: it->second)
-        {
-            set_sub_var_during_solution_extension(it->first, sub_var);
+        for(uint32_t at = flat_offs[i]; at < flat_offs[i+1]; at++) {
+            set_sub_var_during_solution_extension(var, flat_subs[at]);
         }
     }
 }
@@ -667,15 +711,15 @@ void VarReplacer::extend_model_already_set()
 void VarReplacer::extend_model_set_undef()
 {
     assert(solver->model.size() == solver->nVarsOuter());
-    for (auto it = reverseTable.begin() , end = reverseTable.end()
-        ; it != end
-        ; ++it
-    ) {
-        if (solver->model_value(it->first) == l_Undef) {
-            solver->model[it->first] = l_False;
-            for(const uint32_t sub_var: it->second)
-            {
-                set_sub_var_during_solution_extension(it->first, sub_var);
+    if (!flat_valid) {
+        build_flat_reverse_table();
+    }
+    for(size_t i = 0; i < flat_reps.size(); i++) {
+        const uint32_t var = flat_reps[i];
+        if (solver->model_value(var) == l_Undef) {
+            solver->model[var] = l_False;
+            for(uint32_t at = flat_offs[i]; at < flat_offs[i+1]; at++) {
+                set_sub_var_during_solution_extension(var, flat_subs[at]);
             }
         }
     }
@@ -826,6 +870,7 @@ bool VarReplacer::replace(
 
 bool VarReplacer::update_table_and_reversetable(const Lit lit1, const Lit lit2)
 {
+    flat_valid = false;
     if (reverseTable.find(lit1.var()) == reverseTable.end()) {
         reverseTable[lit2.var()].push_back(lit1.var());
         table[lit1.var()] = lit2 ^ lit1.sign();
@@ -972,6 +1017,9 @@ size_t VarReplacer::mem_used() const
     }
     //TODO under-counting
     b += reverseTable.size()*(sizeof(uint32_t) + sizeof(vector<uint32_t>));
+    b += flat_reps.capacity()*sizeof(uint32_t);
+    b += flat_offs.capacity()*sizeof(uint32_t);
+    b += flat_subs.capacity()*sizeof(uint32_t);
 
     return b;
 }
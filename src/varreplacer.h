@@ -53,6 +53,8 @@ class VarReplacer
         void new_var(const uint32_t orig_outer);
         void new_vars(const size_t n);
         void save_on_var_memory();
+        void save_state(SimpleOutFile& f) const;
+        void load_state(SimpleInFile& f);
         bool replace_if_enough_is_found(const size_t limit = 0, uint64_t* bogoprops = NULL, bool* replaced = NULL);
         uint32_t print_equivalent_literals(bool outer_numbering, std::ostream *os = NULL) const;
         void print_some_stats(const double global_cpu_time) const;
@@ -219,6 +221,16 @@ class VarReplacer
         vector<Lit> table; ///<Stores which variables have been replaced by which literals. Index by: table[VAR]
         map<uint32_t, vector<uint32_t> > reverseTable; ///<mapping of variable to set of variables it replaces
 
+        //reverseTable flattened for solution extension, which runs once per
+        //sample: the vars replaced by flat_reps[i] are
+        //flat_subs[flat_offs[i]] .. flat_subs[flat_offs[i+1]-1]. Rebuilt
+        //on first use after the tables change
+        vector<uint32_t> flat_reps;
+        vector<uint32_t> flat_offs;
+        vector<uint32_t> flat_subs;
+        bool flat_valid = false;
+        void build_flat_reverse_table();
+
         //Stats
         void printReplaceStats() const;
         uint64_t replacedVars = 0; ///<Num vars replaced during var-replacement
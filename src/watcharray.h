@@ -26,6 +26,11 @@ THE SOFTWARE.
 
 #include "watched.h"
 #include "Vec.h"
+#include "hugealloc.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <vector>
 
 namespace CMSGen {
@@ -37,10 +42,25 @@ typedef const vec<Watched>& watch_subarray_const;
 class watch_array
 {
 public:
-    vec<vec<Watched> > watches;
     vector<Lit> smudged_list;
     vector<char> smudged;
 
+    watch_array() = default;
+    watch_array(const watch_array&) = delete;
+    watch_array& operator=(const watch_array&) = delete;
+    ~watch_array()
+    {
+        resize_lists(0);
+        set_capacity(0);
+    }
+
+    ///Backing memory of the array of the lists, see SolverConf::huge_pages
+    void set_huge_pages(const HugePages mode)
+    {
+        assert(lists == NULL);
+        huge_pages = mode;
+    }
+
     void smudge(const Lit lit) {
         if (!smudged[lit.toInt()]) {
             smudged_list.push_back(lit);
@@ -63,49 +83,45 @@ public:
 
     watch_subarray operator[](Lit pos)
     {
-        return watches[pos.toInt()];
+        return lists[pos.toInt()];
     }
 
     watch_subarray at(size_t pos)
     {
-        assert(watches.size() > pos);
-        return watches[pos];
+        assert(num > pos);
+        return lists[pos];
     }
 
     watch_subarray_const operator[](Lit at) const
     {
-        return watches[at.toInt()];
+        return lists[at.toInt()];
     }
 
     watch_subarray_const at(size_t pos) const
     {
-        assert(watches.size() > pos);
-        return watches[pos];
+        assert(num > pos);
+        return lists[pos];
     }
 
     void resize(const size_t new_size)
     {
         assert(smudged_list.empty());
-        if (watches.size() < new_size) {
-            watches.growTo(new_size);
-        } else {
-            watches.shrink(watches.size()-new_size);
-        }
+        resize_lists(new_size);
         smudged.resize(new_size, false);
     }
 
-    void insert(uint32_t num)
+    void insert(uint32_t n)
     {
-        smudged.insert(smudged.end(), num, false);
-        watches.insert(num);
+        smudged.insert(smudged.end(), n, false);
+        resize_lists(num + n);
     }
 
     size_t mem_used() const
     {
-        double mem = watches.capacity()*sizeof(vec<Watched>);
-        for(size_t i = 0; i < watches.size(); i++) {
+        double mem = cap*sizeof(vec<Watched>);
+        for(size_t i = 0; i < num; i++) {
             //1.2 is overhead
-            mem += (double)watches[i].capacity()*(double)sizeof(Watched)*1.2;
+            mem += (double)lists[i].capacity()*(double)sizeof(Watched)*1.2;
         }
         mem += smudged.capacity()*sizeof(char);
         mem += smudged_list.capacity()*sizeof(Lit);
@@ -114,50 +130,50 @@ public:
 
     size_t size() const
     {
-        return watches.size();
+        return num;
     }
 
     void prefetch(const size_t at) const
     {
-        cmsat_prefetch(watches[at].data);
+        cmsat_prefetch(lists[at].data);
     }
     typedef vec<Watched>* iterator;
     typedef const vec<Watched>* const_iterator;
 
     iterator begin()
     {
-        return watches.begin();
+        return lists;
     }
 
     iterator end()
     {
-        return watches.end();
+        return lists + num;
     }
 
     const_iterator begin() const
     {
-        return watches.begin();
+        return lists;
     }
 
     const_iterator end() const
     {
-        return watches.end();
+        return lists + num;
     }
 
     void consolidate()
     {
-        /*for(auto& ws: watches) {
+        /*for(auto& ws: *this) {
             ws.shrink_to_fit();
         }*/
-        watches.shrink_to_fit();
+        shrink_to_fit();
     }
 
     void full_consolidate()
     {
-        for(auto& ws: watches) {
+        for(auto& ws: *this) {
             ws.shrink_to_fit();
         }
-        watches.shrink_to_fit();
+        shrink_to_fit();
     }
 
     void print_stat()
@@ -167,7 +183,7 @@ public:
     size_t mem_used_alloc() const
     {
         size_t mem = 0;
-        for(auto& ws: watches) {
+        for(auto& ws: *this) {
             mem += ws.capacity()*sizeof(Watched);
         }
 
@@ -177,10 +193,79 @@ public:
     size_t mem_used_array() const
     {
         size_t mem = 0;
-        mem += watches.capacity()*sizeof(vector<Watched>);
+        mem += cap*sizeof(vec<Watched>);
         mem += sizeof(watch_array);
         return mem;
     }
+
+private:
+    //The lists are "vec"s, so they can be moved around with memcpy
+    vec<Watched>* lists = NULL;
+    uint32_t num = 0;
+    uint32_t cap = 0;
+    HugePages huge_pages = HugePages::none;
+
+    void resize_lists(const size_t new_size)
+    {
+        if (num < new_size) {
+            if (cap < new_size) {
+                // NOTE: grow by approximately 3/2
+                set_capacity(std::max<size_t>(new_size, (size_t)cap + (cap >> 1) + 2));
+            }
+            for (size_t i = num; i < new_size; i++) {
+                new (&lists[i]) vec<Watched>();
+            }
+        } else {
+            for (size_t i = new_size; i < num; i++) {
+                lists[i].~vec<Watched>();
+            }
+        }
+        num = new_size;
+    }
+
+    void shrink_to_fit()
+    {
+        if (huge_alloc_size(num*sizeof(vec<Watched>), huge_pages)
+            < huge_alloc_size(cap*sizeof(vec<Watched>), huge_pages)
+        ) {
+            set_capacity(num);
+        }
+    }
+
+    void set_capacity(const size_t new_cap)
+    {
+        assert(new_cap >= num);
+        if (new_cap == 0) {
+            if (huge_pages == HugePages::none) {
+                free(lists);
+            } else if (lists != NULL) {
+                huge_free(lists, cap*sizeof(vec<Watched>), huge_pages);
+            }
+            lists = NULL;
+            cap = 0;
+            return;
+        }
+
+        if (huge_pages == HugePages::none) {
+            vec<Watched>* new_lists = (vec<Watched>*)realloc(lists, new_cap*sizeof(vec<Watched>));
+            if (new_lists == NULL) {
+                throw std::bad_alloc();
+            }
+            lists = new_lists;
+            cap = new_cap;
+            return;
+        }
+
+        //Whole huge pages are handed out anyway, use all of them
+        const size_t bytes = huge_alloc_size(new_cap*sizeof(vec<Watched>), huge_pages);
+        vec<Watched>* new_lists = (vec<Watched>*)huge_alloc(bytes, alignof(vec<Watched>), huge_pages);
+        if (lists != NULL) {
+            memcpy((void*)new_lists, (void*)lists, num*sizeof(vec<Watched>));
+            huge_free(lists, cap*sizeof(vec<Watched>), huge_pages);
+        }
+        lists = new_lists;
+        cap = bytes/sizeof(vec<Watched>);
+    }
 };
 
 inline void swap(watch_subarray a, watch_subarray b)
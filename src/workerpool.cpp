@@ -0,0 +1,81 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "workerpool.h"
+
+using namespace CMSGen;
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        quit = true;
+    }
+    start_cv.notify_all();
+    for(std::thread& t: threads) {
+        t.join();
+    }
+}
+
+void WorkerPool::run(const size_t num_threads, const std::function<void(size_t)>& work)
+{
+    std::unique_lock<std::mutex> lock(mu);
+    while(threads.size()+1 < num_threads) {
+        threads.push_back(std::thread(&WorkerPool::worker, this, threads.size()+1, generation));
+    }
+    job = &work;
+    job_threads = num_threads;
+    running = num_threads-1;
+    generation++;
+    lock.unlock();
+    start_cv.notify_all();
+
+    work(0);
+
+    lock.lock();
+    done_cv.wait(lock, [&] { return running == 0; });
+    job = NULL;
+}
+
+void WorkerPool::worker(const size_t tid, uint64_t seen)
+{
+    std::unique_lock<std::mutex> lock(mu);
+    while(true) {
+        start_cv.wait(lock, [&] { return quit || generation != seen; });
+        if (quit) {
+            return;
+        }
+        seen = generation;
+        if (tid >= job_threads) {
+            continue;
+        }
+
+        const std::function<void(size_t)>& work = *job;
+        lock.unlock();
+        work(tid);
+        lock.lock();
+        running--;
+        if (running == 0) {
+            done_cv.notify_one();
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CMSGen {
+
+/**
+@brief Threads for the batched, parallel parts of simplification
+
+The threads are started when first needed and wait for the next batch after
+that, so a pass that goes through millions of clauses in small batches does
+not start new threads for each of them.
+*/
+class WorkerPool
+{
+public:
+    WorkerPool() = default;
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    //Calls f(tid, i) for every i in [0, num_items). Item i goes to thread
+    //i % T, where T is at most max_threads, so thread "tid" can use its own
+    //scratch space. Returns when all items are done
+    template<class F>
+    void run_strided(const size_t max_threads, const size_t num_items, F f)
+    {
+        //Small batches are not worth waking threads for
+        const size_t num_threads = std::min<size_t>(
+            max_threads, (num_items+63)/64);
+        if (num_threads <= 1) {
+            for(size_t i = 0; i < num_items; i++) {
+                f(0, i);
+            }
+            return;
+        }
+
+        const std::function<void(size_t)> work = [&](const size_t tid) {
+            for(size_t i = tid; i < num_items; i += num_threads) {
+                f(tid, i);
+            }
+        };
+        run(num_threads, work);
+    }
+
+private:
+    void run(const size_t num_threads, const std::function<void(size_t)>& work);
+    void worker(const size_t tid, uint64_t seen);
+
+    std::vector<std::thread> threads; ///<Thread tid is threads[tid-1]
+    std::mutex mu;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    const std::function<void(size_t)>* job = NULL;
+    size_t job_threads = 0; ///<Threads 0..job_threads-1 work on the job
+    size_t running = 0; ///<Of threads 1..job_threads-1
+    uint64_t generation = 0; ///<Number of jobs started
+    bool quit = false;
+};
+
+}
+
+#endif //WORKERPOOL_H
@@ -41,13 +41,31 @@ XorFinder::XorFinder(OccSimplifier* _occsimplifier, Solver* _solver) :
 {
 }
 
+//Too large clauses are too expensive. With smaller watchlists than this
+//there can't be enough clauses for the XOR, even allowing shortened ones
+bool XorFinder::xor_base_candidate(const Clause& cl) const
+{
+    size_t needed_per_ws = 1ULL << (cl.size()-2);
+    //let's allow shortened clauses
+    needed_per_ws >>= 1;
+
+    for(const Lit lit: cl) {
+        if (solver->watches[lit].size() < needed_per_ws) {
+            return false;
+        }
+        if (solver->watches[~lit].size() < needed_per_ws) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void XorFinder::find_xors_based_on_long_clauses()
 {
     #ifdef DEBUG_MARKED_CLAUSE
     assert(solver->no_marked_clauses());
     #endif
 
-    vector<Lit> lits;
     for (vector<ClOffset>::iterator
         it = occsimplifier->clauses.begin()
         , end = occsimplifier->clauses.end()
@@ -69,27 +87,148 @@ void XorFinder::find_xors_based_on_long_clauses()
         }
 
         //If not tried already, find an XOR with it
-        if (!cl->stats.marked_clause ) {
-            cl->stats.marked_clause = true;
+        ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
+        if (!cl_stats.marked_clause ) {
+            cl_stats.marked_clause = true;
             assert(!cl->getRemoved());
 
-            size_t needed_per_ws = 1ULL << (cl->size()-2);
-            //let's allow shortened clauses
-            needed_per_ws >>= 1;
+            if (xor_base_candidate(*cl)) {
+                cand.offset = offset;
+                findXor(cand, find_data[0]);
+                apply_candidate(cand);
+            }
+        }
+    }
+}
 
-            for(const Lit lit: *cl) {
-                if (solver->watches[lit].size() < needed_per_ws) {
-                    goto next;
-                }
-                if (solver->watches[~lit].size() < needed_per_ws) {
-                    goto next;
-                }
+/**
+@brief Fills the batch with the clauses from "from" that would be tried as bases
+
+Returns where the batch ends. Clauses with the same variables as an earlier
+one in the batch are usually marked by the time they come up, so they are
+not tried ahead of time, only if it's needed.
+*/
+size_t XorFinder::fill_batch(const size_t from)
+{
+    const size_t max_batch = 4096;
+    const vector<ClOffset>& clauses = occsimplifier->clauses;
+    batch_size = 0;
+    batch_vars.clear();
+
+    size_t at = from;
+    for(; at < clauses.size() && batch_size < max_batch; at++) {
+        const ClOffset offset = clauses[at];
+        const Clause* cl = solver->cl_alloc.ptr(offset);
+        if (cl->freed()
+            || cl->getRemoved()
+            || cl->size() > solver->conf.maxXorToFind
+            || solver->cl_alloc.stats(cl).marked_clause
+            || !xor_base_candidate(*cl)
+        ) {
+            continue;
+        }
+
+        if (batch.size() <= batch_size) {
+            batch.resize(batch_size+1);
+        }
+        XorCandidate& c = batch[batch_size];
+        c.offset = offset;
+        c.at = at;
+        c.ahead = false;
+        c.done = false;
+
+        uint64_t h = cl->size();
+        for(const Lit lit: *cl) {
+            h = h*0x9E3779B97F4A7C15ULL + lit.var() + 1;
+        }
+        auto it = batch_vars.find(h);
+        if (it == batch_vars.end()) {
+            batch_vars[h] = batch_size;
+            c.ahead = true;
+        } else if (!same_vars(batch[it->second].offset, offset)) {
+            c.ahead = true;
+        }
+        batch_size++;
+    }
+
+    return at;
+}
+
+bool XorFinder::same_vars(const ClOffset offs1, const ClOffset offs2) const
+{
+    const Clause& cl1 = *solver->cl_alloc.ptr(offs1);
+    const Clause& cl2 = *solver->cl_alloc.ptr(offs2);
+    if (cl1.size() != cl2.size()) {
+        return false;
+    }
+    for(uint32_t i = 0; i < cl1.size(); i++) {
+        if (cl1[i].var() != cl2[i].var()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+@brief Runs findXor() on the candidates of the batch
+
+It only reads the clauses and watchlists, so the candidates are spread over
+conf.xor_find_threads threads, each with its own scratch space.
+*/
+void XorFinder::check_batch()
+{
+    solver->simp_workers.run_strided(solver->conf.xor_find_threads, batch_size
+        , [&](const size_t tid, const size_t i) {
+        if (batch[i].ahead) {
+            findXor(batch[i], find_data[tid]);
+        }
+    });
+}
+
+//The results are applied in clause order, going through the clauses just
+//like find_xors_based_on_long_clauses(), so the same XORs are found
+void XorFinder::find_xors_based_on_long_clauses_batches()
+{
+    #ifdef DEBUG_MARKED_CLAUSE
+    assert(solver->no_marked_clauses());
+    #endif
+
+    const vector<ClOffset>& clauses = occsimplifier->clauses;
+    size_t at = 0;
+    while(at < clauses.size() && xor_find_time_limit > 0) {
+        const size_t batch_end = fill_batch(at);
+        check_batch();
+
+        size_t k = 0;
+        for(; at < batch_end && xor_find_time_limit > 0; at++) {
+            const bool in_batch = k < batch_size && batch[k].at == at;
+            if (in_batch) {
+                k++;
+            }
+
+            Clause* cl = solver->cl_alloc.ptr(clauses[at]);
+            xor_find_time_limit -= 1;
+            if (cl->freed()
+                || cl->getRemoved()
+                || cl->size() > solver->conf.maxXorToFind
+            ) {
+                continue;
+            }
+
+            ClauseStats& cl_stats = solver->cl_alloc.stats(cl);
+            if (cl_stats.marked_clause) {
+                continue;
+            }
+            cl_stats.marked_clause = true;
+            if (!in_batch) {
+                continue;
             }
 
-            lits.resize(cl->size());
-            std::copy(cl->begin(), cl->end(), lits.begin());
-            findXor(lits, offset, cl->abst);
-            next:;
+            XorCandidate& c = batch[k-1];
+            if (!c.done) {
+                findXor(c, find_data[0]);
+            }
+            apply_candidate(c);
         }
     }
 }
@@ -148,7 +287,16 @@ void XorFinder::find_xors()
     assert(solver->no_marked_clauses());
     #endif
 
-    find_xors_based_on_long_clauses();
+    find_data.resize(solver->conf.xor_find_threads);
+    for(FindXorData& d: find_data) {
+        d.seen.clear();
+        d.seen.resize(solver->nVars(), 0);
+    }
+    if (solver->conf.xor_find_threads > 1) {
+        find_xors_based_on_long_clauses_batches();
+    } else {
+        find_xors_based_on_long_clauses();
+    }
     assert(runStats.foundXors == xors.size());
 
     //clean them of equivalent XORs
@@ -158,7 +306,7 @@ void XorFinder::find_xors()
     //Cleanup
     for(ClOffset offset: occsimplifier->clauses) {
         Clause* cl = solver->cl_alloc.ptr(offset);
-        cl->stats.marked_clause = false;
+        solver->cl_alloc.stats(cl).marked_clause = false;
     }
 
     //Print stats
@@ -201,11 +349,24 @@ void XorFinder::add_xors_to_solver()
     #endif
 }
 
-void XorFinder::findXor(vector<Lit>& lits, const ClOffset offset, cl_abst_type abst)
+/**
+@brief Tries to find an XOR with c.offset as its base clause
+
+Nothing is changed, what was found is put into "c" and is applied by
+apply_candidate(). The time used is also recorded there.
+*/
+void XorFinder::findXor(XorCandidate& c, FindXorData& d) const
 {
+    const Clause& cl = *solver->cl_alloc.ptr(c.offset);
+    vector<Lit>& lits = d.lits;
+    lits.assign(cl.begin(), cl.end());
+    c.same_size.clear();
+    c.used.clear();
+
     //Set this clause as the base for the XOR, fill 'seen'
-    xor_find_time_limit -= lits.size()/4+1;
-    poss_xor.setup(lits, offset, abst, occcnt);
+    c.time_used = lits.size()/4+1;
+    PossibleXor& poss_xor = d.poss_xor;
+    poss_xor.setup(lits, c.offset, cl.abst, d.seen);
 
     //Run findXorMatch for the 2 smallest watchlists
     Lit slit = lit_Undef;
@@ -227,31 +388,49 @@ void XorFinder::findXor(vector<Lit>& lits, const ClOffset offset, cl_abst_type a
             smallest2 = num;
         }
     }
-    findXorMatch(solver->watches[slit], slit);
-    findXorMatch(solver->watches[~slit], ~slit);
+    findXorMatch(solver->watches[slit], slit, c, d);
+    findXorMatch(solver->watches[~slit], ~slit, c, d);
 
     if (lits.size() <= solver->conf.maxXorToFindSlow) {
-        findXorMatch(solver->watches[slit2], slit2);
-        findXorMatch(solver->watches[~slit2], ~slit2);
+        findXorMatch(solver->watches[slit2], slit2, c, d);
+        findXorMatch(solver->watches[~slit2], ~slit2, c, d);
+    }
+
+    c.found = poss_xor.foundAll();
+    if (c.found) {
+        c.rhs = poss_xor.getRHS();
+        c.used = poss_xor.get_offsets();
     }
+    poss_xor.clear_seen(d.seen);
+    c.done = true;
+}
 
-    if (poss_xor.foundAll()) {
-        std::sort(lits.begin(), lits.end());
-        Xor found_xor(lits, poss_xor.getRHS());
+void XorFinder::apply_candidate(const XorCandidate& c)
+{
+    xor_find_time_limit -= c.time_used;
+
+    //No point in using these as bases, the same would be found
+    for(ClOffset offs: c.same_size) {
+        solver->cl_alloc.stats(solver->cl_alloc.ptr(offs)).marked_clause = true;
+    }
+
+    if (c.found) {
+        //The clause is sorted
+        const Clause& base = *solver->cl_alloc.ptr(c.offset);
+        Xor found_xor(base, c.rhs);
         #if defined(SLOW_DEBUG) || defined(XOR_DEBUG)
-        for(Lit lit: lits) {
+        for(Lit lit: base) {
             assert(solver->varData[lit.var()].removed == Removed::none);
         }
         #endif
 
         add_found_xor(found_xor);
-        for(ClOffset offs: poss_xor.get_offsets()) {
+        for(ClOffset offs: c.used) {
             Clause* cl = solver->cl_alloc.ptr(offs);
             assert(!cl->getRemoved());
             cl->set_used_in_xor(true);
         }
     }
-    poss_xor.clear_seen(occcnt);
 }
 
 void XorFinder::add_found_xor(const Xor& found_xor)
@@ -263,9 +442,15 @@ void XorFinder::add_found_xor(const Xor& found_xor)
     runStats.minsize = std::min<uint32_t>(runStats.minsize, found_xor.size());
 }
 
-void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
-{
-    xor_find_time_limit -= (int64_t)occ.size()/8+1;
+void XorFinder::findXorMatch(
+    watch_subarray_const occ
+    , const Lit wlit
+    , XorCandidate& c
+    , FindXorData& d
+) const {
+    PossibleXor& poss_xor = d.poss_xor;
+    vector<Lit>& binvec = d.binvec;
+    c.time_used += (int64_t)occ.size()/8+1;
     for (const Watched& w: occ) {
         if (w.isIdx()) {
             continue;
@@ -274,9 +459,9 @@ void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
 
         if (w.isBin()) {
             #ifdef SLOW_DEBUG
-            assert(occcnt[wlit.var()]);
+            assert(d.seen[wlit.var()]);
             #endif
-            if (!occcnt[w.lit2().var()]) {
+            if (!d.seen[w.lit2().var()]) {
                 goto end;
             }
 
@@ -288,8 +473,8 @@ void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
                 std::swap(binvec[0], binvec[1]);
             }
 
-            xor_find_time_limit -= 1;
-            poss_xor.add(binvec, std::numeric_limits<ClOffset>::max(), varsMissing);
+            c.time_used += 1;
+            poss_xor.add(binvec, std::numeric_limits<ClOffset>::max(), d.varsMissing);
             if (poss_xor.foundAll())
                 break;
         } else {
@@ -304,9 +489,9 @@ void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
             if ((w.getBlockedLit().toInt() | poss_xor.getAbst()) != poss_xor.getAbst())
                 continue;
 
-            xor_find_time_limit -= 3;
+            c.time_used += 3;
             const ClOffset offset = w.get_offset();
-            Clause& cl = *solver->cl_alloc.ptr(offset);
+            const Clause& cl = *solver->cl_alloc.ptr(offset);
             if (cl.freed() || cl.getRemoved()) {
                 //Clauses are ordered!!
                 break;
@@ -337,7 +522,7 @@ void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
             bool rhs = true;
             for (const Lit cl_lit :cl) {
                 //early-abort, contains literals not in original clause
-                if (!occcnt[cl_lit.var()])
+                if (!d.seen[cl_lit.var()])
                     goto end;
 
                 rhs ^= cl_lit.sign();
@@ -350,11 +535,11 @@ void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
             //there is no point in using this clause as a base for another XOR
             //because exactly the same things will be found.
             if (cl.size() == poss_xor.getSize()) {
-                cl.stats.marked_clause = true;;
+                c.same_size.push_back(offset);
             }
 
-            xor_find_time_limit -= cl.size()/4+1;
-            poss_xor.add(cl, offset, varsMissing);
+            c.time_used += cl.size()/4+1;
+            poss_xor.add(cl, offset, d.varsMissing);
             if (poss_xor.foundAll())
                 break;
         }
@@ -368,7 +553,7 @@ void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
         const TransCache& cache1 = solver->implCache[wlit];
         for (const LitExtra litExtra: cache1.lits) {
             const Lit otherlit = litExtra.getLit();
-            if (!occcnt[otherlit.var()]) {
+            if (!d.seen[otherlit.var()]) {
                 continue;
             }
 
@@ -380,8 +565,8 @@ void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
                 std::swap(binvec[0], binvec[1]);
             }
 
-            xor_find_time_limit -= 1;
-            poss_xor.add(binvec, std::numeric_limits<ClOffset>::max(), varsMissing);
+            c.time_used += 1;
+            poss_xor.add(binvec, std::numeric_limits<ClOffset>::max(), d.varsMissing);
             if (poss_xor.foundAll())
                 break;
         }
@@ -794,8 +979,11 @@ size_t XorFinder::mem_used() const
     mem += xors.capacity()*sizeof(Xor);
 
     //Temporary
-    mem += tmpClause.capacity()*sizeof(Lit);
-    mem += varsMissing.capacity()*sizeof(uint32_t);
+    for(const FindXorData& d: find_data) {
+        mem += d.seen.capacity()*sizeof(uint32_t);
+        mem += d.varsMissing.capacity()*sizeof(uint32_t);
+    }
+    mem += batch.capacity()*sizeof(XorCandidate);
 
     return mem;
 }
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include <algorithm>
 #include <set>
 #include <limits>
+#include <unordered_map>
 #include "constants.h"
 #include "xor.h"
 #include "cset.h"
@@ -180,9 +181,38 @@ public:
     vector<Xor> xors;
 
 private:
-    PossibleXor poss_xor;
+    //What findXor() found with a clause as base
+    struct XorCandidate
+    {
+        ClOffset offset;
+        size_t at; ///<Position in OccSimplifier::clauses
+        bool ahead; ///<Tried on the worker threads
+        bool done;
+        bool found;
+        bool rhs;
+        int64_t time_used;
+        vector<ClOffset> used; ///<Clauses the XOR is made of
+        vector<ClOffset> same_size; ///<Matched clauses of the base's size, they'd find the same
+    };
+
+    //Scratch space of findXor(), one per thread
+    struct FindXorData
+    {
+        PossibleXor poss_xor;
+        vector<uint32_t> seen;
+        vector<uint32_t> varsMissing;
+        vector<Lit> binvec;
+        vector<Lit> lits;
+    };
+
     void add_found_xor(const Xor& found_xor);
+    void apply_candidate(const XorCandidate& c);
     void find_xors_based_on_long_clauses();
+    void find_xors_based_on_long_clauses_batches();
+    bool xor_base_candidate(const Clause& cl) const;
+    size_t fill_batch(const size_t from);
+    void check_batch();
+    bool same_vars(const ClOffset offs1, const ClOffset offs2) const;
     void print_found_xors();
     bool xor_has_interesting_var(const Xor& x);
     void clean_xors_from_empty();
@@ -195,10 +225,20 @@ private:
     int64_t xor_find_time_limit;
 
     //Find XORs
-    void findXor(vector<Lit>& lits, const ClOffset offset, cl_abst_type abst);
+    void findXor(XorCandidate& c, FindXorData& d) const;
 
     ///Normal finding of matching clause for XOR
-    void findXorMatch(watch_subarray_const occ, const Lit wlit);
+    void findXorMatch(
+        watch_subarray_const occ
+        , const Lit wlit
+        , XorCandidate& c
+        , FindXorData& d
+    ) const;
+    vector<FindXorData> find_data;
+    XorCandidate cand;
+    vector<XorCandidate> batch;
+    size_t batch_size = 0;
+    std::unordered_map<uint64_t, size_t> batch_vars; ///<Hash of vars -> first candidate with them
 
     OccSimplifier* occsimplifier;
     Solver *solver;
@@ -207,11 +247,6 @@ private:
     Stats runStats;
     Stats globalStats;
 
-    //Temporary
-    vector<Lit> tmpClause;
-    vector<uint32_t> varsMissing;
-    vector<Lit> binvec;
-
     //Other temporaries
     vector<uint32_t> occcnt;
     vector<Lit>& toClear;
@@ -0,0 +1,149 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+//Adds the same clauses once through SATSolver::add_clauses() and once one by
+//one through add_clause(), and checks that both solvers give the same result
+//and the same models. The batches hold the odd cases: units in the middle of
+//a batch, empty clauses, tautologies, duplicate literals, and vars that are
+//only created between two batches.
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "cmsgen.h"
+#include "test_util.h"
+
+using namespace CMSGenTest;
+using CMSGen::SATSolver;
+using CMSGen::Lit;
+using CMSGen::lbool;
+
+typedef vector<vector<int> > Batch;
+
+static Lit to_lit(const int l)
+{
+    return Lit(std::abs(l)-1, l < 0);
+}
+
+static void new_vars_for(SATSolver& s, const Batch& batch)
+{
+    uint32_t max_var = 0;
+    for(const auto& cl: batch) {
+        for(const int l: cl) {
+            max_var = std::max<uint32_t>(max_var, std::abs(l));
+        }
+    }
+    if (max_var > s.nVars()) {
+        s.new_vars(max_var - s.nVars());
+    }
+}
+
+static void add_bulk(SATSolver& s, const Batch& batch)
+{
+    new_vars_for(s, batch);
+    vector<Lit> lits;
+    vector<size_t> offsets(1, 0);
+    for(const auto& cl: batch) {
+        for(const int l: cl) {
+            lits.push_back(to_lit(l));
+        }
+        offsets.push_back(lits.size());
+    }
+    s.add_clauses(lits, offsets);
+}
+
+static void add_one_by_one(SATSolver& s, const Batch& batch)
+{
+    new_vars_for(s, batch);
+    vector<Lit> lits;
+    for(const auto& cl: batch) {
+        lits.clear();
+        for(const int l: cl) {
+            lits.push_back(to_lit(l));
+        }
+        s.add_clause(lits);
+    }
+}
+
+static void check_same(const string& name, const vector<Batch>& batches, const lbool expected)
+{
+    SATSolver bulk;
+    SATSolver one;
+    for(const Batch& batch: batches) {
+        add_bulk(bulk, batch);
+        add_one_by_one(one, batch);
+    }
+    CHECK(bulk.nVars() == one.nVars());
+
+    //Every solve() gives a new sample, they must agree too
+    for(uint32_t i = 0; i < 5; i++) {
+        const lbool ret_bulk = bulk.solve();
+        const lbool ret_one = one.solve();
+        if (ret_bulk != expected || ret_one != expected) {
+            std::cerr << name << ": expected " << expected << ", got "
+            << ret_bulk << " with add_clauses() and "
+            << ret_one << " with add_clause()" << std::endl;
+            num_failed++;
+            return;
+        }
+        if (expected == l_True && bulk.get_model() != one.get_model()) {
+            std::cerr << name << ": solve() number " << i
+            << " gives different models" << std::endl;
+            num_failed++;
+        }
+    }
+}
+
+int main()
+{
+    const Batch base = planted_cnf(30, 110, 5);
+
+    //Vars 31..40 are created only for the second batch. [31] propagates
+    //over the binary before it, which is still waiting to be attached
+    const Batch sat = {
+        {-31, 32}
+        , {-32, 33, 34}
+        , {33, -35, 36, 37}
+        , {31}
+        , {34, 34, -38, 34}
+        , {35, -35, 39}
+        , {-33, -34, 40}
+        , {12, -12}
+        , {38, 39, 40, 1}
+        , {-36, 36, -36}
+        , {37, -39}
+    };
+    check_same("sat", {base, sat}, l_True);
+
+    //All in a single batch
+    Batch single = base;
+    single.insert(single.begin() + 50, sat.begin(), sat.end());
+    check_same("single_batch", {single}, l_True);
+
+    const Batch empty = {{1, 2}, {}, {3, 4}};
+    check_same("empty_clause", {base, empty}, l_False);
+
+    const Batch units = {{2, 33}, {5}, {-5, 6, 6}, {7, -7}, {-6}, {8, 9}};
+    check_same("conflicting_units", {base, units}, l_False);
+
+    return report("bulk_test");
+}
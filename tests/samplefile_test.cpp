@@ -0,0 +1,114 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+//Samples the same CNF with the same seed in text and in binary format
+//(--sampleformat bin), reads the binary file back with SampleFileReader and
+//checks that it holds exactly the text samples.
+//Usage: samplefile_test CMSGEN_BINARY WORK_DIR
+
+#include <algorithm>
+
+#include "samplefile.h"
+#include "test_util.h"
+
+using namespace CMSGenTest;
+using CMSGen::SampleFileReader;
+
+static void check_same_samples(
+    const string& cmsgen
+    , const string& dir
+    , const string& cnf
+    , const string& extra_args
+    , const string& name
+) {
+    const string txt = dir + "/" + name + ".txt";
+    const string bin = dir + "/" + name + ".bin";
+    const string args = "--seed 7 --samples 100 " + extra_args;
+    CHECK(run_cmsgen(cmsgen, args + " --samplefile " + txt + " " + cnf
+        , dir + "/" + name + "_txt.log") == 10);
+    CHECK(run_cmsgen(cmsgen, args + " --sampleformat bin --samplefile " + bin
+        + " " + cnf, dir + "/" + name + "_bin.log") == 10);
+
+    const vector<vector<int> > text = read_text_samples(txt);
+    SampleFileReader reader;
+    if (!reader.open(bin)) {
+        std::cerr << name << ": " << reader.error() << std::endl;
+        num_failed++;
+        return;
+    }
+    CHECK(text.size() == 100);
+    CHECK(reader.num_samples() == text.size());
+    CHECK(reader.get_bytes_per_sample() == (reader.num_vars()+7)/8);
+
+    vector<int> lits;
+    for(uint64_t s = 0; s < std::min<uint64_t>(reader.num_samples(), text.size()); s++) {
+        reader.get_lits(s, lits);
+        vector<int> expected = text[s];
+        auto by_var = [](int a, int b) { return std::abs(a) < std::abs(b); };
+        std::sort(lits.begin(), lits.end(), by_var);
+        std::sort(expected.begin(), expected.end(), by_var);
+        if (lits != expected) {
+            std::cerr << name << ": sample " << s
+            << " differs between text and binary format" << std::endl;
+            num_failed++;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " CMSGEN_BINARY WORK_DIR" << std::endl;
+        return 1;
+    }
+    const string cmsgen = argv[1];
+    const string dir = argv[2];
+
+    //Not a multiple of 8 vars, so the last byte of each sample is padded
+    const uint32_t num_vars = 37;
+    const string cnf = dir + "/samplefile_test.cnf";
+    write_cnf(cnf, num_vars, planted_cnf(num_vars, 120, 1));
+    check_same_samples(cmsgen, dir, cnf, "", "samplefile_all");
+
+    SampleFileReader reader;
+    CHECK(reader.open(dir + "/samplefile_all.bin"));
+    CHECK(reader.num_vars() == num_vars);
+    CHECK(!reader.only_sampling_vars());
+    for(uint32_t i = 0; i < reader.num_vars(); i++) {
+        CHECK(reader.var(i) == i+1);
+    }
+
+    //Only the sampling vars, in the order given in the CNF
+    const vector<uint32_t> ind = {30, 2, 17, 5, 11, 23, 8, 36, 1};
+    const string cnf_ind = dir + "/samplefile_test_ind.cnf";
+    write_cnf(cnf_ind, num_vars, planted_cnf(num_vars, 120, 2), ind);
+    check_same_samples(cmsgen, dir, cnf_ind, "--onlysampling", "samplefile_ind");
+
+    CHECK(reader.open(dir + "/samplefile_ind.bin"));
+    CHECK(reader.only_sampling_vars());
+    CHECK(reader.num_vars() == ind.size());
+    for(uint32_t i = 0; i < reader.num_vars() && i < ind.size(); i++) {
+        CHECK(reader.var(i) == ind[i]);
+    }
+
+    return report("samplefile_test");
+}
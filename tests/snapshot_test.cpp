@@ -0,0 +1,164 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+//Saves a snapshot with --snapshot, loads it back and checks that the
+//samples of the loaded problem satisfy the CNF. Then changes the CNF, once
+//keeping its size, and checks that the stale snapshot is rebuilt. Last,
+//saves and loads the snapshot of an UNSAT CNF.
+//Usage: snapshot_test CMSGEN_BINARY WORK_DIR
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "test_util.h"
+
+using namespace CMSGenTest;
+
+static const uint32_t num_vars = 40;
+static const uint32_t num_samples = 50;
+
+static bool satisfies(const vector<vector<int> >& cls, const vector<int>& sample)
+{
+    vector<int> val(num_vars+1, 0);
+    for(const int lit: sample) {
+        if (std::abs(lit) <= (int)num_vars) {
+            val[std::abs(lit)] = lit;
+        }
+    }
+    for(const auto& cl: cls) {
+        bool sat = false;
+        for(const int lit: cl) {
+            sat |= (val[std::abs(lit)] == lit);
+        }
+        if (!sat) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Run
+{
+    int ret;
+    string log;
+    vector<vector<int> > samples;
+};
+
+static Run sample_with_snapshot(
+    const string& cmsgen
+    , const string& dir
+    , const string& cnf
+    , const string& snap
+    , const string& name
+) {
+    Run r;
+    const string out = dir + "/" + name + ".txt";
+    r.log = dir + "/" + name + ".log";
+    r.ret = run_cmsgen(cmsgen, "--verb 1 --seed 3 --samples "
+        + std::to_string(num_samples) + " --samplefile " + out
+        + " --snapshot " + snap + " " + cnf, r.log);
+    r.samples = read_text_samples(out);
+    return r;
+}
+
+static void check_samples(const Run& r, const vector<vector<int> >& cls)
+{
+    CHECK(r.ret == 10);
+    CHECK(r.samples.size() == num_samples);
+    for(const auto& sample: r.samples) {
+        CHECK(sample.size() == num_vars);
+        CHECK(satisfies(cls, sample));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " CMSGEN_BINARY WORK_DIR" << std::endl;
+        return 1;
+    }
+    const string cmsgen = argv[1];
+    const string dir = argv[2];
+    const string cnf = dir + "/snapshot_test.cnf";
+    const string snap = dir + "/snapshot_test.snap";
+    std::remove(snap.c_str());
+
+    //No snapshot yet: parse, simplify and save it
+    vector<vector<int> > cls = planted_cnf(num_vars, 160, 3);
+    write_cnf(cnf, num_vars, cls);
+    Run saved = sample_with_snapshot(cmsgen, dir, cnf, snap, "snapshot_save");
+    check_samples(saved, cls);
+    CHECK(file_contains(saved.log, "Saved snapshot"));
+
+    //Load it back, twice, the same way
+    Run loaded = sample_with_snapshot(cmsgen, dir, cnf, snap, "snapshot_load");
+    check_samples(loaded, cls);
+    CHECK(file_contains(loaded.log, "Loaded snapshot"));
+    CHECK(!file_contains(loaded.log, "Saved snapshot"));
+    Run loaded2 = sample_with_snapshot(cmsgen, dir, cnf, snap, "snapshot_load2");
+    CHECK(loaded2.samples == loaded.samples);
+
+    //Different CNF: the snapshot must be rebuilt from it, not reused
+    cls = planted_cnf(num_vars, 160, 4);
+    write_cnf(cnf, num_vars, cls);
+    Run changed = sample_with_snapshot(cmsgen, dir, cnf, snap, "snapshot_changed");
+    check_samples(changed, cls);
+    CHECK(file_contains(changed.log, "rebuilding"));
+    CHECK(file_contains(changed.log, "Saved snapshot"));
+    Run changed_loaded = sample_with_snapshot(cmsgen, dir, cnf, snap, "snapshot_changed_load");
+    check_samples(changed_loaded, cls);
+    CHECK(file_contains(changed_loaded.log, "Loaded snapshot"));
+
+    //Same size, different contents: caught by the hash
+    const string before = read_file(cnf);
+    std::swap(cls[0], cls[1]);
+    for(auto& cl: cls) {
+        if (cl[0] != cl[1]) {
+            std::swap(cl[0], cl[1]);
+            break;
+        }
+    }
+    write_cnf(cnf, num_vars, cls);
+    CHECK(read_file(cnf).size() == before.size());
+    CHECK(read_file(cnf) != before);
+    Run same_size = sample_with_snapshot(cmsgen, dir, cnf, snap, "snapshot_same_size");
+    check_samples(same_size, cls);
+    CHECK(file_contains(same_size.log, "rebuilding"));
+
+    //UNSAT: nothing but that is stored, sampling vars included
+    const string unsat_cnf = dir + "/snapshot_test_unsat.cnf";
+    const string unsat_snap = dir + "/snapshot_test_unsat.snap";
+    std::remove(unsat_snap.c_str());
+    cls = planted_cnf(num_vars, 160, 5);
+    cls.push_back({1});
+    cls.push_back({-1});
+    write_cnf(unsat_cnf, num_vars, cls, {1, 2, 3});
+    for(const string name: {"snapshot_unsat_save", "snapshot_unsat_load"}) {
+        const string log = dir + "/" + name + ".log";
+        CHECK(run_cmsgen(cmsgen, "--verb 1 --onlysampling --samplefile "
+            + dir + "/" + name + ".txt --snapshot " + unsat_snap + " "
+            + unsat_cnf, log) == 20);
+    }
+    CHECK(file_contains(dir + "/snapshot_unsat_load.log", "holds an UNSAT problem"));
+
+    return report("snapshot_test");
+}
@@ -0,0 +1,167 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+//Helpers for the round-trip tests. They drive the cmsgen binary given on
+//the command line, the same way users do.
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+
+namespace CMSGenTest {
+
+using std::string;
+using std::vector;
+
+static int num_failed = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ \
+            << ": check failed: " #cond << std::endl; \
+            CMSGenTest::num_failed++; \
+        } \
+    } while(0)
+
+//Random 3-CNF that is satisfied by a planted assignment, so it is always SAT
+inline vector<vector<int> > planted_cnf(
+    uint32_t num_vars
+    , uint32_t num_cls
+    , uint64_t seed
+) {
+    uint64_t x = seed*0x9E3779B97F4A7C15ULL + 1;
+    auto next = [&](uint32_t n) -> uint32_t {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return (x >> 32) % n;
+    };
+
+    vector<bool> planted(num_vars+1);
+    for(uint32_t v = 1; v <= num_vars; v++) {
+        planted[v] = next(2);
+    }
+    vector<vector<int> > cls;
+    while(cls.size() < num_cls) {
+        vector<int> cl;
+        bool sat = false;
+        for(uint32_t i = 0; i < 3; i++) {
+            const int v = next(num_vars)+1;
+            const bool neg = next(2);
+            cl.push_back(neg ? -v : v);
+            sat |= (planted[v] != neg);
+        }
+        if (sat) {
+            cls.push_back(cl);
+        }
+    }
+    return cls;
+}
+
+inline void write_cnf(
+    const string& fname
+    , uint32_t num_vars
+    , const vector<vector<int> >& cls
+    , const vector<uint32_t>& ind = vector<uint32_t>()
+) {
+    std::ofstream f(fname);
+    f << "p cnf " << num_vars << " " << cls.size() << "\n";
+    if (!ind.empty()) {
+        f << "c ind";
+        for(const uint32_t v: ind) {
+            f << " " << v;
+        }
+        f << " 0\n";
+    }
+    for(const auto& cl: cls) {
+        for(const int l: cl) {
+            f << l << " ";
+        }
+        f << "0\n";
+    }
+}
+
+//Runs the solver with "args", its output going to "log". Returns its exit status
+inline int run_cmsgen(const string& cmsgen, const string& args, const string& log)
+{
+    const string cmd = cmsgen + " " + args + " > " + log + " 2>&1";
+    const int ret = std::system(cmd.c_str());
+    if (ret == -1 || !WIFEXITED(ret)) {
+        std::cerr << "Could not run: " << cmd << std::endl;
+        return -1;
+    }
+    return WEXITSTATUS(ret);
+}
+
+//Text samples, one vector of DIMACS literals per line
+inline vector<vector<int> > read_text_samples(const string& fname)
+{
+    vector<vector<int> > samples;
+    std::ifstream f(fname);
+    string line;
+    while(std::getline(f, line)) {
+        std::istringstream ss(line);
+        vector<int> lits;
+        int lit;
+        while(ss >> lit && lit != 0) {
+            lits.push_back(lit);
+        }
+        samples.push_back(lits);
+    }
+    return samples;
+}
+
+inline string read_file(const string& fname)
+{
+    std::ifstream f(fname, std::ios::binary);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+inline bool file_contains(const string& fname, const string& what)
+{
+    return read_file(fname).find(what) != string::npos;
+}
+
+inline int report(const char* name)
+{
+    if (num_failed) {
+        std::cerr << name << ": " << num_failed << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << name << ": all checks passed" << std::endl;
+    return 0;
+}
+
+}
+
+#endif //TEST_UTIL_H